@@ -0,0 +1,101 @@
+#pragma once
+
+#include "VirtualArena.hpp"
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// Allocateur standard puisant dans une VirtualArena, pour router le stockage d'un registre EnTT :
+//
+// VirtualArena arena(16ull * 1024 * 1024 * 1024, true);
+// ArenaRegistry registry{ ArenaAllocator<entt::entity>(arena) };
+// registry.storage<Position>().reserve(10'000'000); //< Ne coûte que de l'espace d'adressage
+//
+// Le registre transmet son allocateur à chacun de ses pools. Un allocateur construit par défaut (sans arène)
+// se rabat sur le tas global, ce qui permet au registre de fonctionner aussi sans arène.
+template<typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	using propagate_on_container_copy_assignment = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	ArenaAllocator() noexcept;
+	ArenaAllocator(VirtualArena& arena) noexcept;
+	template<typename U> ArenaAllocator(const ArenaAllocator<U>& allocator) noexcept;
+
+	T* allocate(std::size_t count);
+	void deallocate(T* pointer, std::size_t count) noexcept;
+
+	VirtualArena* GetArena() const noexcept;
+
+	template<typename U> bool operator==(const ArenaAllocator<U>& allocator) const noexcept;
+	template<typename U> bool operator!=(const ArenaAllocator<U>& allocator) const noexcept;
+
+private:
+	VirtualArena* m_arena;
+};
+
+// Registre dont tous les pools (entités comme composants) vivent dans une VirtualArena
+using ArenaRegistry = entt::basic_registry<entt::entity, ArenaAllocator<entt::entity>>;
+
+template<typename T>
+ArenaAllocator<T>::ArenaAllocator() noexcept :
+m_arena(nullptr)
+{
+}
+
+template<typename T>
+ArenaAllocator<T>::ArenaAllocator(VirtualArena& arena) noexcept :
+m_arena(&arena)
+{
+}
+
+template<typename T>
+template<typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U>& allocator) noexcept :
+m_arena(allocator.GetArena())
+{
+}
+
+template<typename T>
+T* ArenaAllocator<T>::allocate(std::size_t count)
+{
+	if (!m_arena)
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+
+	return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+}
+
+template<typename T>
+void ArenaAllocator<T>::deallocate(T* pointer, std::size_t count) noexcept
+{
+	if (!m_arena)
+		return ::operator delete(pointer, count * sizeof(T), std::align_val_t(alignof(T)));
+
+	m_arena->Deallocate(pointer, count * sizeof(T), alignof(T));
+}
+
+template<typename T>
+VirtualArena* ArenaAllocator<T>::GetArena() const noexcept
+{
+	return m_arena;
+}
+
+template<typename T>
+template<typename U>
+bool ArenaAllocator<T>::operator==(const ArenaAllocator<U>& allocator) const noexcept
+{
+	return m_arena == allocator.GetArena();
+}
+
+template<typename T>
+template<typename U>
+bool ArenaAllocator<T>::operator!=(const ArenaAllocator<U>& allocator) const noexcept
+{
+	return m_arena != allocator.GetArena();
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "Behaviour.hpp"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+Behaviour Behaviour::promise_type::get_return_object()
+{
+	return Behaviour(Handle::from_promise(*this));
+}
+
+void Behaviour::promise_type::unhandled_exception()
+{
+	// L'exception est relancée par le scheduler, sur le thread qui fait avancer les comportements
+	exception = std::current_exception();
+}
+
+void* Behaviour::promise_type::operator new(std::size_t size)
+{
+	return CoroutineFramePool::Allocate(size);
+}
+
+void Behaviour::promise_type::operator delete(void* pointer, std::size_t size)
+{
+	CoroutineFramePool::Deallocate(pointer, size);
+}
+
+Behaviour::Behaviour(Handle handle) :
+m_handle(handle)
+{
+}
+
+Behaviour::Behaviour(Behaviour&& behaviour) noexcept
+{
+	m_handle = behaviour.m_handle;
+	behaviour.m_handle = nullptr;
+}
+
+Behaviour::~Behaviour()
+{
+	if (m_handle)
+		m_handle.destroy();
+}
+
+Behaviour::Handle Behaviour::Release()
+{
+	return std::exchange(m_handle, nullptr);
+}
+
+Behaviour& Behaviour::operator=(Behaviour&& behaviour) noexcept
+{
+	if (m_handle)
+		m_handle.destroy();
+
+	m_handle = behaviour.m_handle;
+	behaviour.m_handle = nullptr;
+
+	return *this;
+}
+
+void WaitFor::await_suspend(Behaviour::Handle handle) const noexcept
+{
+	Behaviour::promise_type& promise = handle.promise();
+	promise.wakeTime = promise.scheduler->GetTime() + duration;
+}
+
+void NextFrame::await_suspend(Behaviour::Handle handle) const noexcept
+{
+	Behaviour::promise_type& promise = handle.promise();
+	promise.wakeTime = promise.scheduler->GetTime();
+}
+
+BehaviourScheduler::BehaviourScheduler(entt::registry& registry) :
+m_registry(registry),
+m_time(0.0)
+{
+}
+
+BehaviourScheduler::~BehaviourScheduler()
+{
+	for (SleepingBehaviour& behaviour : m_sleepingBehaviours)
+		behaviour.handle.destroy();
+}
+
+std::size_t BehaviourScheduler::GetBehaviourCount() const
+{
+	return m_sleepingBehaviours.size();
+}
+
+double BehaviourScheduler::GetTime() const
+{
+	return m_time;
+}
+
+void BehaviourScheduler::Start(entt::entity entity, Behaviour behaviour)
+{
+	// Le comportement démarre à la prochaine mise à jour
+	Behaviour::Handle handle = behaviour.Release();
+	if (!handle)
+		return; //< Comportement vide (déplacé ou déjà démarré)
+
+	handle.promise().scheduler = this;
+	handle.promise().wakeTime = m_time;
+
+	Schedule(entity, handle);
+}
+
+void BehaviourScheduler::Update(float elapsedTime)
+{
+	m_time += elapsedTime;
+
+	// On sort d'abord tous les comportements dont l'attente est écoulée avant de les reprendre,
+	// sans quoi un comportement attendant la frame suivante serait repris plusieurs fois dans la même mise à jour
+	m_readyBehaviours.clear();
+	while (!m_sleepingBehaviours.empty() && m_sleepingBehaviours.front().wakeTime <= m_time)
+	{
+		std::pop_heap(m_sleepingBehaviours.begin(), m_sleepingBehaviours.end(), std::greater<>{});
+		m_readyBehaviours.push_back(m_sleepingBehaviours.back());
+		m_sleepingBehaviours.pop_back();
+	}
+
+	for (std::size_t i = 0; i < m_readyBehaviours.size(); ++i)
+	{
+		SleepingBehaviour& behaviour = m_readyBehaviours[i];
+		if (!m_registry.valid(behaviour.entity))
+		{
+			behaviour.handle.destroy();
+			continue;
+		}
+
+		behaviour.handle.resume();
+
+		if (std::exception_ptr exception = behaviour.handle.promise().exception)
+		{
+			// Les comportements restant à reprendre sont rendormis pour la prochaine mise à jour
+			behaviour.handle.destroy();
+			for (std::size_t j = i + 1; j < m_readyBehaviours.size(); ++j)
+				Schedule(m_readyBehaviours[j].entity, m_readyBehaviours[j].handle);
+
+			std::rethrow_exception(exception);
+		}
+
+		if (behaviour.handle.done())
+			behaviour.handle.destroy();
+		else
+			Schedule(behaviour.entity, behaviour.handle);
+	}
+}
+
+void BehaviourScheduler::Schedule(entt::entity entity, Behaviour::Handle handle)
+{
+	m_sleepingBehaviours.push_back({ handle.promise().wakeTime, entity, handle });
+	std::push_heap(m_sleepingBehaviours.begin(), m_sleepingBehaviours.end(), std::greater<>{});
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoroutineFramePool.hpp"
+#include <entt/entt.hpp>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+class BehaviourScheduler;
+
+// Comportement scripté d'une entité, écrit comme une coroutine C++20 :
+//
+// Behaviour Patrol(entt::registry& registry, entt::entity entity)
+// {
+//     for (;;)
+//     {
+//         co_await WaitFor(2.f);
+//         registry.get<Velocity>(entity).x = -500.f;
+//     }
+// }
+//
+// Plutôt que d'écrire une machine à états à la main, la coroutine est suspendue à chaque co_await
+// et reprise par le BehaviourScheduler une fois son attente écoulée.
+class Behaviour
+{
+public:
+	struct promise_type
+	{
+		Behaviour get_return_object();
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception();
+
+		// Les frames des coroutines viennent d'un pool plutôt que du tas global
+		static void* operator new(std::size_t size);
+		static void operator delete(void* pointer, std::size_t size);
+
+		std::exception_ptr exception;
+		BehaviourScheduler* scheduler = nullptr;
+		double wakeTime = 0.0;
+	};
+
+	using Handle = std::coroutine_handle<promise_type>;
+
+	explicit Behaviour(Handle handle);
+	Behaviour(const Behaviour&) = delete;
+	Behaviour(Behaviour&& behaviour) noexcept;
+	~Behaviour();
+
+	Handle Release();
+
+	Behaviour& operator=(const Behaviour&) = delete;
+	Behaviour& operator=(Behaviour&& behaviour) noexcept;
+
+private:
+	Handle m_handle;
+};
+
+// co_await WaitFor(seconds) suspend le comportement pendant la durée donnée
+struct WaitFor
+{
+	float duration;
+
+	bool await_ready() const noexcept { return duration <= 0.f; }
+	void await_suspend(Behaviour::Handle handle) const noexcept;
+	void await_resume() const noexcept {}
+};
+
+// co_await NextFrame() suspend le comportement jusqu'à la prochaine mise à jour
+struct NextFrame
+{
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(Behaviour::Handle handle) const noexcept;
+	void await_resume() const noexcept {}
+};
+
+// Fait avancer les comportements attachés aux entités.
+// Les comportements endormis sont rangés dans un tas trié par heure de réveil : une mise à jour ne touche
+// que ceux dont l'attente est écoulée, des milliers de comportements endormis ne coûtent donc rien.
+// Le comportement d'une entité détruite est simplement abandonné à son réveil.
+class BehaviourScheduler
+{
+public:
+	BehaviourScheduler(entt::registry& registry);
+	BehaviourScheduler(const BehaviourScheduler&) = delete;
+	BehaviourScheduler(BehaviourScheduler&&) = delete;
+	~BehaviourScheduler();
+
+	std::size_t GetBehaviourCount() const;
+	double GetTime() const;
+
+	void Start(entt::entity entity, Behaviour behaviour);
+
+	void Update(float elapsedTime);
+
+	BehaviourScheduler& operator=(const BehaviourScheduler&) = delete;
+	BehaviourScheduler& operator=(BehaviourScheduler&&) = delete;
+
+private:
+	struct SleepingBehaviour
+	{
+		double wakeTime;
+		entt::entity entity;
+		Behaviour::Handle handle;
+
+		bool operator>(const SleepingBehaviour& other) const { return wakeTime > other.wakeTime; }
+	};
+
+	void Schedule(entt::entity entity, Behaviour::Handle handle);
+
+	std::vector<SleepingBehaviour> m_readyBehaviours;
+	std::vector<SleepingBehaviour> m_sleepingBehaviours;
+	entt::registry& m_registry;
+	double m_time;
+};
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "BitStream.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+void BitWriter::Clear()
+{
+	m_data.clear();
+	m_bitCount = 0;
+}
+
+const std::vector<std::uint8_t>& BitWriter::GetData() const
+{
+	return m_data;
+}
+
+std::size_t BitWriter::GetBitCount() const
+{
+	return m_bitCount;
+}
+
+void BitWriter::WriteBits(std::uint32_t value, unsigned int bitCount)
+{
+	// Les bits sont écrits du poids faible au poids fort, octet par octet
+	while (bitCount > 0)
+	{
+		if (m_bitCount % 8 == 0)
+			m_data.push_back(0);
+
+		unsigned int bitOffset = m_bitCount % 8;
+		unsigned int writtenBits = std::min(8 - bitOffset, bitCount);
+		std::uint32_t mask = (1u << writtenBits) - 1;
+
+		m_data.back() |= static_cast<std::uint8_t>((value & mask) << bitOffset);
+
+		value = (writtenBits < 32) ? value >> writtenBits : 0;
+		bitCount -= writtenBits;
+		m_bitCount += writtenBits;
+	}
+}
+
+void BitWriter::WriteVarUInt(std::uint32_t value)
+{
+	// Groupes de 7 bits précédés d'un bit de continuation : les petites valeurs (les plus fréquentes) tiennent sur 8 bits
+	do
+	{
+		std::uint32_t group = value & 0x7F;
+		value >>= 7;
+
+		WriteBits((value != 0) ? 1 : 0, 1);
+		WriteBits(group, 7);
+	}
+	while (value != 0);
+}
+
+BitReader::BitReader(const std::uint8_t* data, std::size_t size) :
+m_data(data),
+m_bitCount(size * 8),
+m_bitOffset(0)
+{
+}
+
+std::uint32_t BitReader::ReadBits(unsigned int bitCount)
+{
+	if (m_bitOffset + bitCount > m_bitCount)
+		throw std::runtime_error("bit stream is too short");
+
+	std::uint32_t value = 0;
+	unsigned int readBits = 0;
+	while (readBits < bitCount)
+	{
+		unsigned int bitOffset = m_bitOffset % 8;
+		unsigned int chunkBits = std::min(8 - bitOffset, bitCount - readBits);
+		std::uint32_t chunk = (m_data[m_bitOffset / 8] >> bitOffset) & ((1u << chunkBits) - 1);
+
+		value |= chunk << readBits;
+		readBits += chunkBits;
+		m_bitOffset += chunkBits;
+	}
+
+	return value;
+}
+
+std::uint32_t BitReader::ReadVarUInt()
+{
+	std::uint32_t value = 0;
+	for (unsigned int shift = 0; shift < 35; shift += 7)
+	{
+		bool hasMore = ReadBits(1) != 0;
+		value |= ReadBits(7) << shift;
+
+		if (!hasMore)
+			return value;
+	}
+
+	throw std::runtime_error("malformed variable-length integer");
+}
\ No newline at end of file
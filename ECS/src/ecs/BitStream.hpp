@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Écriture de valeurs sur un nombre arbitraire de bits, pour des paquets réseau aussi compacts que possible
+class BitWriter
+{
+public:
+	BitWriter() = default;
+	BitWriter(const BitWriter&) = default;
+	BitWriter(BitWriter&&) = default;
+	~BitWriter() = default;
+
+	void Clear();
+
+	const std::vector<std::uint8_t>& GetData() const;
+	std::size_t GetBitCount() const;
+
+	void WriteBits(std::uint32_t value, unsigned int bitCount);
+	void WriteVarUInt(std::uint32_t value);
+
+	BitWriter& operator=(const BitWriter&) = default;
+	BitWriter& operator=(BitWriter&&) = default;
+
+private:
+	std::vector<std::uint8_t> m_data;
+	std::size_t m_bitCount = 0;
+};
+
+// Lecture des valeurs écrites par un BitWriter, lève une exception si le flux est trop court
+class BitReader
+{
+public:
+	BitReader(const std::uint8_t* data, std::size_t size);
+	BitReader(const BitReader&) = default;
+	BitReader(BitReader&&) = default;
+	~BitReader() = default;
+
+	std::uint32_t ReadBits(unsigned int bitCount);
+	std::uint32_t ReadVarUInt();
+
+	BitReader& operator=(const BitReader&) = default;
+	BitReader& operator=(BitReader&&) = default;
+
+private:
+	const std::uint8_t* m_data;
+	std::size_t m_bitCount;
+	std::size_t m_bitOffset;
+};
\ No newline at end of file
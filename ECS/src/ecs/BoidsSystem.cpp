@@ -0,0 +1,354 @@
+#include "BoidsSystem.hpp"
+#include "Components.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+	// Colonne ou ligne de la grille où tombe une position, bornée à la grille même pour une position aberrante (infinie ou NaN)
+	std::uint32_t GetCellCoordinate(float offset, float cellSize, std::uint32_t cellCount)
+	{
+		float coordinate = offset / cellSize;
+		if (!(coordinate >= 0.f))
+			return 0;
+
+		if (coordinate >= static_cast<float>(cellCount - 1))
+			return cellCount - 1;
+
+		return static_cast<std::uint32_t>(coordinate);
+	}
+}
+
+// SSE2 est toujours disponible en x86-64, ailleurs on se contente de la version scalaire
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOIDS_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef BOIDS_USE_SSE2
+namespace
+{
+	float HorizontalSum(__m128 value)
+	{
+		__m128 shuffled = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+		__m128 sums = _mm_add_ps(value, shuffled);
+		shuffled = _mm_movehl_ps(shuffled, sums);
+		sums = _mm_add_ss(sums, shuffled);
+
+		return _mm_cvtss_f32(sums);
+	}
+}
+#endif
+
+// Sommes accumulées sur les voisins d'un boid
+struct BoidsSystem::NeighbourSums
+{
+	float count = 0.f;
+	float positionX = 0.f;
+	float positionY = 0.f;
+	float velocityX = 0.f;
+	float velocityY = 0.f;
+	float separationX = 0.f;
+	float separationY = 0.f;
+};
+
+BoidsSystem::BoidsSystem(ThreadPool& threadPool, const BoidsSettings& settings) :
+m_settings(settings),
+m_threadPool(threadPool),
+m_cellSize(settings.perceptionRadius),
+m_gridMinX(0.f),
+m_gridMinY(0.f),
+m_gridHeight(0),
+m_gridWidth(0)
+{
+	CheckSettings(settings);
+}
+
+const BoidsSettings& BoidsSystem::GetSettings() const
+{
+	return m_settings;
+}
+
+void BoidsSystem::SetSettings(const BoidsSettings& settings)
+{
+	CheckSettings(settings);
+	m_settings = settings;
+}
+
+void BoidsSystem::Update(entt::registry& registry, float elapsedTime)
+{
+	// On recopie les boids dans des tableaux contigus (les vecteurs gardent leur capacité d'un tick à l'autre)
+	m_entities.clear();
+	m_positionX.clear();
+	m_positionY.clear();
+	m_velocityX.clear();
+	m_velocityY.clear();
+
+	auto view = registry.view<Position, Velocity, Boid>();
+	for (entt::entity entity : view)
+	{
+		auto& entityPos = view.get<Position>(entity);
+		auto& entityVel = view.get<Velocity>(entity);
+
+		m_entities.push_back(entity);
+		m_positionX.push_back(entityPos.x);
+		m_positionY.push_back(entityPos.y);
+		m_velocityX.push_back(entityVel.x);
+		m_velocityY.push_back(entityVel.y);
+	}
+
+	if (m_entities.empty())
+		return;
+
+	BuildGrid();
+
+	// Les nouvelles vitesses sont calculées à partir des anciennes uniquement (double buffer),
+	// le résultat ne dépend donc pas de l'ordre de traitement et chaque boid peut être traité par n'importe quel thread
+	m_threadPool.ParallelFor(m_sortedEntities.size(), 1024, [&](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+			ComputeSteering(i, elapsedTime);
+	});
+
+	for (std::size_t i = 0; i < m_sortedEntities.size(); ++i)
+	{
+		auto& entityVel = registry.get<Velocity>(m_sortedEntities[i]);
+		entityVel.x = m_newVelocityX[i];
+		entityVel.y = m_newVelocityY[i];
+	}
+}
+
+void BoidsSystem::AccumulateNeighbours(std::uint32_t begin, std::uint32_t end, std::uint32_t self, float x, float y, NeighbourSums& sums) const
+{
+	float perceptionRadiusSq = m_settings.perceptionRadius * m_settings.perceptionRadius;
+	float separationRadiusSq = m_settings.separationRadius * m_settings.separationRadius;
+
+	std::uint32_t i = begin;
+
+#ifdef BOIDS_USE_SSE2
+	// Quatre voisins à la fois : les conditions deviennent des masques, il n'y a donc aucun branchement
+	__m128 boidX = _mm_set1_ps(x);
+	__m128 boidY = _mm_set1_ps(y);
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 epsilon = _mm_set1_ps(0.0001f);
+	__m128 perceptionSq = _mm_set1_ps(perceptionRadiusSq);
+	__m128 separationSq = _mm_set1_ps(separationRadiusSq);
+	__m128i selfIndex = _mm_set1_epi32(static_cast<int>(self));
+	__m128i laneOffsets = _mm_setr_epi32(0, 1, 2, 3);
+
+	__m128 count = _mm_setzero_ps();
+	__m128 positionX = _mm_setzero_ps();
+	__m128 positionY = _mm_setzero_ps();
+	__m128 velocityX = _mm_setzero_ps();
+	__m128 velocityY = _mm_setzero_ps();
+	__m128 separationX = _mm_setzero_ps();
+	__m128 separationY = _mm_setzero_ps();
+
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 otherX = _mm_loadu_ps(&m_sortedPositionX[i]);
+		__m128 otherY = _mm_loadu_ps(&m_sortedPositionY[i]);
+		__m128 dx = _mm_sub_ps(otherX, boidX);
+		__m128 dy = _mm_sub_ps(otherY, boidY);
+		__m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+		// Le boid lui-même est reconnu à son indice : deux boids confondus restent voisins l'un de l'autre
+		__m128i indices = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(i)), laneOffsets);
+		__m128 isSelf = _mm_castsi128_ps(_mm_cmpeq_epi32(indices, selfIndex));
+		__m128 isNeighbour = _mm_andnot_ps(isSelf, _mm_cmplt_ps(distSq, perceptionSq));
+		count = _mm_add_ps(count, _mm_and_ps(isNeighbour, one));
+		positionX = _mm_add_ps(positionX, _mm_and_ps(isNeighbour, otherX));
+		positionY = _mm_add_ps(positionY, _mm_and_ps(isNeighbour, otherY));
+		velocityX = _mm_add_ps(velocityX, _mm_and_ps(isNeighbour, _mm_loadu_ps(&m_sortedVelocityX[i])));
+		velocityY = _mm_add_ps(velocityY, _mm_and_ps(isNeighbour, _mm_loadu_ps(&m_sortedVelocityY[i])));
+
+		__m128 isTooClose = _mm_andnot_ps(isSelf, _mm_cmplt_ps(distSq, separationSq));
+		__m128 repulsion = _mm_and_ps(isTooClose, _mm_div_ps(one, _mm_add_ps(distSq, epsilon)));
+		separationX = _mm_sub_ps(separationX, _mm_mul_ps(dx, repulsion));
+		separationY = _mm_sub_ps(separationY, _mm_mul_ps(dy, repulsion));
+	}
+
+	sums.count += HorizontalSum(count);
+	sums.positionX += HorizontalSum(positionX);
+	sums.positionY += HorizontalSum(positionY);
+	sums.velocityX += HorizontalSum(velocityX);
+	sums.velocityY += HorizontalSum(velocityY);
+	sums.separationX += HorizontalSum(separationX);
+	sums.separationY += HorizontalSum(separationY);
+#endif
+
+	// Voisins restants (ou tous les voisins sans SSE2)
+	for (; i < end; ++i)
+	{
+		float dx = m_sortedPositionX[i] - x;
+		float dy = m_sortedPositionY[i] - y;
+		float distSq = dx * dx + dy * dy;
+
+		if (i == self)
+			continue;
+
+		if (distSq < perceptionRadiusSq)
+		{
+			sums.count += 1.f;
+			sums.positionX += m_sortedPositionX[i];
+			sums.positionY += m_sortedPositionY[i];
+			sums.velocityX += m_sortedVelocityX[i];
+			sums.velocityY += m_sortedVelocityY[i];
+		}
+
+		// La répulsion est d'autant plus forte que le voisin est proche (l'epsilon évite la division par zéro pour un voisin confondu)
+		if (distSq < separationRadiusSq)
+		{
+			float repulsion = 1.f / (distSq + 0.0001f);
+			sums.separationX -= dx * repulsion;
+			sums.separationY -= dy * repulsion;
+		}
+	}
+}
+
+void BoidsSystem::BuildGrid()
+{
+	std::size_t boidCount = m_entities.size();
+
+	m_gridMinX = *std::min_element(m_positionX.begin(), m_positionX.end());
+	m_gridMinY = *std::min_element(m_positionY.begin(), m_positionY.end());
+	float maxX = *std::max_element(m_positionX.begin(), m_positionX.end());
+	float maxY = *std::max_element(m_positionY.begin(), m_positionY.end());
+
+	// Une cellule est au moins aussi grande que le rayon de perception, les voisins d'un boid sont donc
+	// forcément dans sa cellule ou l'une des huit cellules adjacentes.
+	// Si les boids sont très dispersés, on agrandit les cellules pour ne pas avoir bien plus de cellules que de boids
+	// Les dimensions sont calculées en double et ne sont converties en entiers qu'une fois la grille assez petite,
+	// une étendue énorme ne peut donc pas dépasser la capacité d'un std::uint32_t
+	double extentX = static_cast<double>(maxX) - m_gridMinX;
+	double extentY = static_cast<double>(maxY) - m_gridMinY;
+	double maxCellCount = static_cast<double>(boidCount) * 4.0 + 1024.0;
+
+	m_cellSize = m_settings.perceptionRadius;
+	if (std::isfinite(extentX) && std::isfinite(extentY))
+	{
+		for (;;)
+		{
+			double columnCount = std::floor(extentX / m_cellSize) + 1.0;
+			double rowCount = std::floor(extentY / m_cellSize) + 1.0;
+			if (columnCount * rowCount <= maxCellCount)
+			{
+				m_gridWidth = static_cast<std::uint32_t>(columnCount);
+				m_gridHeight = static_cast<std::uint32_t>(rowCount);
+				break;
+			}
+
+			m_cellSize *= 2.f;
+		}
+	}
+	else
+	{
+		// Une position infinie ou NaN ne permet pas de découper l'espace : tous les boids sont rangés dans une seule cellule
+		m_gridWidth = 1;
+		m_gridHeight = 1;
+	}
+
+	std::size_t cellCount = static_cast<std::size_t>(m_gridWidth) * m_gridHeight;
+
+	// Tri par comptage : on compte le nombre de boids par cellule, on en déduit où commence chaque cellule,
+	// puis on range chaque boid à sa place
+	m_cellIndices.resize(boidCount);
+	m_cellStarts.assign(cellCount + 1, 0);
+	for (std::size_t i = 0; i < boidCount; ++i)
+	{
+		m_cellIndices[i] = GetCellIndex(m_positionX[i], m_positionY[i]);
+		m_cellStarts[m_cellIndices[i] + 1]++;
+	}
+
+	for (std::size_t cell = 0; cell < cellCount; ++cell)
+		m_cellStarts[cell + 1] += m_cellStarts[cell];
+
+	m_newVelocityX.resize(boidCount);
+	m_newVelocityY.resize(boidCount);
+	m_sortedEntities.resize(boidCount);
+	m_sortedPositionX.resize(boidCount);
+	m_sortedPositionY.resize(boidCount);
+	m_sortedVelocityX.resize(boidCount);
+	m_sortedVelocityY.resize(boidCount);
+
+	// Chaque cellule a son curseur d'insertion, partant du début de la cellule
+	m_insertOffsets.assign(m_cellStarts.begin(), m_cellStarts.end() - 1);
+	for (std::size_t i = 0; i < boidCount; ++i)
+	{
+		std::uint32_t index = m_insertOffsets[m_cellIndices[i]]++;
+		m_sortedEntities[index] = m_entities[i];
+		m_sortedPositionX[index] = m_positionX[i];
+		m_sortedPositionY[index] = m_positionY[i];
+		m_sortedVelocityX[index] = m_velocityX[i];
+		m_sortedVelocityY[index] = m_velocityY[i];
+	}
+}
+
+void BoidsSystem::ComputeSteering(std::size_t boid, float elapsedTime)
+{
+	float x = m_sortedPositionX[boid];
+	float y = m_sortedPositionY[boid];
+
+	NeighbourSums sums;
+
+	std::uint32_t cellIndex = GetCellIndex(x, y);
+	std::uint32_t cellX = cellIndex % m_gridWidth;
+	std::uint32_t cellY = cellIndex / m_gridWidth;
+
+	std::uint32_t firstColumn = (cellX > 0) ? cellX - 1 : 0;
+	std::uint32_t lastColumn = std::min(cellX + 1, m_gridWidth - 1);
+	std::uint32_t firstRow = (cellY > 0) ? cellY - 1 : 0;
+	std::uint32_t lastRow = std::min(cellY + 1, m_gridHeight - 1);
+
+	for (std::uint32_t row = firstRow; row <= lastRow; ++row)
+	{
+		// Les cellules d'une même ligne étant contiguës, les trois cellules voisines d'une ligne
+		// forment une seule plage de boids contigus en mémoire
+		std::uint32_t begin = m_cellStarts[row * m_gridWidth + firstColumn];
+		std::uint32_t end = m_cellStarts[row * m_gridWidth + lastColumn + 1];
+
+		AccumulateNeighbours(begin, end, static_cast<std::uint32_t>(boid), x, y, sums);
+	}
+
+	float velocityX = m_sortedVelocityX[boid];
+	float velocityY = m_sortedVelocityY[boid];
+
+	if (sums.count > 0.f)
+	{
+		float invCount = 1.f / sums.count;
+
+		float alignmentX = sums.velocityX * invCount - velocityX;
+		float alignmentY = sums.velocityY * invCount - velocityY;
+		float cohesionX = sums.positionX * invCount - x;
+		float cohesionY = sums.positionY * invCount - y;
+
+		velocityX += (alignmentX * m_settings.alignmentWeight + cohesionX * m_settings.cohesionWeight + sums.separationX * m_settings.separationWeight) * elapsedTime;
+		velocityY += (alignmentY * m_settings.alignmentWeight + cohesionY * m_settings.cohesionWeight + sums.separationY * m_settings.separationWeight) * elapsedTime;
+	}
+
+	float speed = std::sqrt(velocityX * velocityX + velocityY * velocityY);
+	if (speed > m_settings.maxSpeed)
+	{
+		velocityX *= m_settings.maxSpeed / speed;
+		velocityY *= m_settings.maxSpeed / speed;
+	}
+
+	m_newVelocityX[boid] = velocityX;
+	m_newVelocityY[boid] = velocityY;
+}
+
+std::uint32_t BoidsSystem::GetCellIndex(float x, float y) const
+{
+	std::uint32_t cellX = GetCellCoordinate(x - m_gridMinX, m_cellSize, m_gridWidth);
+	std::uint32_t cellY = GetCellCoordinate(y - m_gridMinY, m_cellSize, m_gridHeight);
+
+	return cellY * m_gridWidth + cellX;
+}
+
+void BoidsSystem::CheckSettings(const BoidsSettings& settings)
+{
+	// Le rayon de perception sert de taille aux cellules de la grille
+	if (!(settings.perceptionRadius > 0.f))
+		throw std::runtime_error("boids perception radius must be positive");
+}
\ No newline at end of file
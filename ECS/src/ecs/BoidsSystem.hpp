@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ThreadPool.hpp"
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct BoidsSettings
+{
+	float perceptionRadius = 50.f;
+	float separationRadius = 15.f;
+	float alignmentWeight = 2.f;
+	float cohesionWeight = 1.f;
+	float separationWeight = 5000.f;
+	float maxSpeed = 300.f;
+};
+
+// Comportement de nuée (boids) pour les entités ayant Position, Velocity et le tag Boid :
+// chaque boid s'éloigne de ses voisins trop proches (séparation), s'aligne sur leur vitesse moyenne (alignement)
+// et se rapproche de leur position moyenne (cohésion).
+// Les voisins sont trouvés grâce à une grille reconstruite à chaque tick par un tri par comptage (counting sort),
+// ce qui garde la recherche en O(n) et range les boids d'une même cellule de façon contiguë en mémoire.
+class BoidsSystem
+{
+public:
+	BoidsSystem(ThreadPool& threadPool, const BoidsSettings& settings = BoidsSettings{});
+	BoidsSystem(const BoidsSystem&) = delete;
+	BoidsSystem(BoidsSystem&&) = delete;
+	~BoidsSystem() = default;
+
+	const BoidsSettings& GetSettings() const;
+
+	void SetSettings(const BoidsSettings& settings);
+
+	void Update(entt::registry& registry, float elapsedTime);
+
+	BoidsSystem& operator=(const BoidsSystem&) = delete;
+	BoidsSystem& operator=(BoidsSystem&&) = delete;
+
+private:
+	struct NeighbourSums;
+
+	void AccumulateNeighbours(std::uint32_t begin, std::uint32_t end, std::uint32_t self, float x, float y, NeighbourSums& sums) const;
+	void BuildGrid();
+	void ComputeSteering(std::size_t boid, float elapsedTime);
+	std::uint32_t GetCellIndex(float x, float y) const;
+
+	static void CheckSettings(const BoidsSettings& settings);
+
+	std::vector<entt::entity> m_entities;
+	std::vector<entt::entity> m_sortedEntities;
+	std::vector<float> m_newVelocityX;
+	std::vector<float> m_newVelocityY;
+	std::vector<float> m_sortedPositionX;
+	std::vector<float> m_sortedPositionY;
+	std::vector<float> m_sortedVelocityX;
+	std::vector<float> m_sortedVelocityY;
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_velocityX;
+	std::vector<float> m_velocityY;
+	std::vector<std::uint32_t> m_cellIndices;
+	std::vector<std::uint32_t> m_cellStarts;
+	std::vector<std::uint32_t> m_insertOffsets;
+	BoidsSettings m_settings;
+	ThreadPool& m_threadPool;
+	float m_cellSize;
+	float m_gridMinX;
+	float m_gridMinY;
+	std::uint32_t m_gridHeight;
+	std::uint32_t m_gridWidth;
+};
\ No newline at end of file
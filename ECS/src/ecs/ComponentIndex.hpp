@@ -0,0 +1,161 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+// Index associant la valeur d'un composant (un nom, un identifiant réseau...) aux entités qui le possèdent :
+//
+// ComponentIndex<std::string> names(registry);
+// entt::entity albert = names.Find("Albert");
+//
+// Retrouver une entité par son nom demanderait sinon de parcourir toute une vue, l'index répond en O(1).
+// Il est tenu à jour automatiquement via les signaux on_construct/on_update/on_destroy du registre,
+// ce qui implique de modifier la clé avec registry.replace ou registry.patch (une modification
+// directe via registry.get ne déclenche aucun signal et laisserait l'index périmé).
+// Plusieurs entités peuvent partager la même clé.
+template<typename Component, typename Hash = std::hash<Component>, typename KeyEqual = std::equal_to<Component>>
+class ComponentIndex
+{
+public:
+	ComponentIndex(entt::registry& registry);
+	ComponentIndex(const ComponentIndex&) = delete;
+	ComponentIndex(ComponentIndex&&) = delete;
+	~ComponentIndex();
+
+	std::size_t Count(const Component& key) const;
+
+	entt::entity Find(const Component& key) const;
+	template<typename F> void ForEach(const Component& key, F&& func) const;
+
+	std::size_t GetSize() const;
+
+	ComponentIndex& operator=(const ComponentIndex&) = delete;
+	ComponentIndex& operator=(ComponentIndex&&) = delete;
+
+private:
+	void Erase(const Component& key, entt::entity entity);
+	void Insert(const Component& key, entt::entity entity);
+
+	void OnConstruct(entt::registry& registry, entt::entity entity);
+	void OnDestroy(entt::registry& registry, entt::entity entity);
+	void OnUpdate(entt::registry& registry, entt::entity entity);
+
+	// on_update est émis après la modification : l'ancienne clé de chaque entité est conservée
+	// pour pouvoir retirer l'entrée correspondante
+	std::unordered_map<entt::entity, Component> m_keys;
+	std::unordered_multimap<Component, entt::entity, Hash, KeyEqual> m_entities;
+	entt::registry& m_registry;
+};
+
+template<typename Component, typename Hash, typename KeyEqual>
+ComponentIndex<Component, Hash, KeyEqual>::ComponentIndex(entt::registry& registry) :
+m_registry(registry)
+{
+	// Les entités possédant déjà le composant sont indexées immédiatement
+	auto view = m_registry.view<Component>();
+	m_entities.reserve(view.size());
+	m_keys.reserve(view.size());
+	for (entt::entity entity : view)
+		Insert(view.template get<Component>(entity), entity);
+
+	m_registry.on_construct<Component>().template connect<&ComponentIndex::OnConstruct>(*this);
+	m_registry.on_update<Component>().template connect<&ComponentIndex::OnUpdate>(*this);
+	m_registry.on_destroy<Component>().template connect<&ComponentIndex::OnDestroy>(*this);
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+ComponentIndex<Component, Hash, KeyEqual>::~ComponentIndex()
+{
+	m_registry.on_construct<Component>().template disconnect<&ComponentIndex::OnConstruct>(*this);
+	m_registry.on_update<Component>().template disconnect<&ComponentIndex::OnUpdate>(*this);
+	m_registry.on_destroy<Component>().template disconnect<&ComponentIndex::OnDestroy>(*this);
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+std::size_t ComponentIndex<Component, Hash, KeyEqual>::Count(const Component& key) const
+{
+	return m_entities.count(key);
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+entt::entity ComponentIndex<Component, Hash, KeyEqual>::Find(const Component& key) const
+{
+	auto it = m_entities.find(key);
+	if (it == m_entities.end())
+		return entt::null;
+
+	return it->second;
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+template<typename F>
+void ComponentIndex<Component, Hash, KeyEqual>::ForEach(const Component& key, F&& func) const
+{
+	auto range = m_entities.equal_range(key);
+	for (auto it = range.first; it != range.second; ++it)
+		func(it->second);
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+std::size_t ComponentIndex<Component, Hash, KeyEqual>::GetSize() const
+{
+	return m_keys.size();
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+void ComponentIndex<Component, Hash, KeyEqual>::Erase(const Component& key, entt::entity entity)
+{
+	auto range = m_entities.equal_range(key);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second == entity)
+		{
+			m_entities.erase(it);
+			break;
+		}
+	}
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+void ComponentIndex<Component, Hash, KeyEqual>::Insert(const Component& key, entt::entity entity)
+{
+	m_entities.emplace(key, entity);
+	m_keys.insert_or_assign(entity, key);
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+void ComponentIndex<Component, Hash, KeyEqual>::OnConstruct(entt::registry& registry, entt::entity entity)
+{
+	Insert(registry.get<Component>(entity), entity);
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+void ComponentIndex<Component, Hash, KeyEqual>::OnDestroy(entt::registry& /*registry*/, entt::entity entity)
+{
+	auto it = m_keys.find(entity);
+	if (it == m_keys.end())
+		return;
+
+	Erase(it->second, entity);
+	m_keys.erase(it);
+}
+
+template<typename Component, typename Hash, typename KeyEqual>
+void ComponentIndex<Component, Hash, KeyEqual>::OnUpdate(entt::registry& registry, entt::entity entity)
+{
+	const Component& newKey = registry.get<Component>(entity);
+
+	auto it = m_keys.find(entity);
+	if (it != m_keys.end())
+	{
+		if (KeyEqual{}(it->second, newKey))
+			return;
+
+		Erase(it->second, entity);
+		m_keys.erase(it);
+	}
+
+	Insert(newKey, entity);
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "sdlcpp/SDLppTexture.hpp"
+#include <memory>
+
+struct Position
+{
+	float x = 0.f;
+	float y = 0.f;
+};
+
+struct Velocity
+{
+	float x = 0.f;
+	float y = 0.f;
+};
+
+struct Drawable
+{
+	int width;
+	int height;
+	std::shared_ptr<SDLppTexture> texture;
+	SDL_Rect sourceRect = { 0, 0, 0, 0 }; //< Partie de la texture à afficher (une région d'atlas par exemple), toute la texture si vide
+};
+
+struct NoGravity {};
+
+// Les entités ayant ce tag se déplacent en nuée (BoidsSystem)
+struct Boid {};
+
+// Les entités ayant ce composant suivent le champ de flux vers le joueur (FlowFieldSystem)
+struct FlowFieldAgent
+{
+	float speed = 200.f;
+};
+
+// Masse d'une entité soumise à l'attraction mutuelle des corps (NBodyGravitySystem)
+struct Mass
+{
+	float value = 1.f;
+};
+
+// Copie en lecture seule d'une entité appartenant à un shard voisin (SpatialShard)
+// Sans tag de bucket, elle n'est jamais mise à jour localement : elle n'est visible que des requêtes de voisinage
+struct Ghost {};
+
+struct Input
+{
+	bool left = false;
+	bool right = false;
+	bool up = false;
+	bool down = false;
+};
+
+// Toutes les entités n'ont pas besoin d'être mises à jour à chaque frame : une entité loin du joueur et
+// hors de l'écran peut très bien n'avancer qu'une frame sur huit sans que personne ne s'en aperçoive.
+// On répartit donc les entités dans des "buckets" de mise à jour, représentés par des composants tags
+// (comme NoGravity), ce qui permet aux vues de ne parcourir que les entités d'un bucket donné.
+// Les buckets de plus d'une frame sont eux-mêmes découpés en phases (voir UpdatePhase) : une entité n'y est donc
+// rangée qu'à travers SetUpdateBucket (UpdateClock.hpp), seul UpdateEveryFrame peut être ajouté directement.
+struct UpdateEveryFrame
+{
+	static constexpr unsigned int Period = 1;
+};
+
+struct UpdateEvery2Frames
+{
+	static constexpr unsigned int Period = 2;
+};
+
+struct UpdateEvery8Frames
+{
+	static constexpr unsigned int Period = 8;
+};
+
+// Phase d'une entité dans son bucket : elle est mise à jour pendant les frames dont l'indice, modulo la période, vaut Phase.
+// Chaque phase étant un composant distinct, une frame ne parcourt que les entités de la phase en cours :
+// les entités des autres phases ne coûtent rien, pas même un test
+template<typename Bucket, unsigned int PhaseValue>
+struct UpdatePhase
+{
+	static constexpr unsigned int Phase = PhaseValue;
+};
\ No newline at end of file
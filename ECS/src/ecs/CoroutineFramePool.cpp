@@ -0,0 +1,72 @@
+#include "CoroutineFramePool.hpp"
+#include <array>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace
+{
+	// Les tailles sont arrondies au multiple de 64 octets supérieur, les frames de plus de 2 Ko passent par le tas global
+	constexpr std::size_t SizeClassStep = 64;
+	constexpr std::size_t SizeClassCount = 32;
+	constexpr std::size_t BlocksPerChunk = 64;
+
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	struct ThreadPools
+	{
+		std::array<FreeBlock*, SizeClassCount> freeLists = {};
+		std::vector<std::unique_ptr<std::byte[]>> chunks;
+	};
+
+	thread_local ThreadPools s_pools;
+
+	std::size_t GetSizeClass(std::size_t size)
+	{
+		return (size + SizeClassStep - 1) / SizeClassStep - 1;
+	}
+}
+
+void* CoroutineFramePool::Allocate(std::size_t size)
+{
+	std::size_t sizeClass = GetSizeClass(size);
+	if (size == 0 || sizeClass >= SizeClassCount)
+		return ::operator new(size);
+
+	FreeBlock*& freeList = s_pools.freeLists[sizeClass];
+	if (!freeList)
+	{
+		// Plus de bloc libre de cette taille : on alloue un nouveau morceau que l'on découpe en blocs
+		std::size_t blockSize = (sizeClass + 1) * SizeClassStep;
+		std::byte* chunk = s_pools.chunks.emplace_back(std::make_unique<std::byte[]>(blockSize * BlocksPerChunk)).get();
+
+		for (std::size_t i = 0; i < BlocksPerChunk; ++i)
+		{
+			FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+			block->next = freeList;
+			freeList = block;
+		}
+	}
+
+	FreeBlock* block = freeList;
+	freeList = block->next;
+
+	return block;
+}
+
+void CoroutineFramePool::Deallocate(void* pointer, std::size_t size)
+{
+	std::size_t sizeClass = GetSizeClass(size);
+	if (size == 0 || sizeClass >= SizeClassCount)
+	{
+		::operator delete(pointer);
+		return;
+	}
+
+	FreeBlock* block = static_cast<FreeBlock*>(pointer);
+	block->next = s_pools.freeLists[sizeClass];
+	s_pools.freeLists[sizeClass] = block;
+}
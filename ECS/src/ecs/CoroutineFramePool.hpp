@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+// Allocateur des frames de coroutines : plutôt que de passer par le tas global à chaque création de coroutine,
+// les frames sont découpées dans de gros blocs et recyclées via une liste de blocs libres par classe de taille.
+// Les listes sont propres à chaque thread (aucun verrou), une frame doit donc être libérée sur le thread qui l'a allouée.
+class CoroutineFramePool
+{
+public:
+	CoroutineFramePool() = delete;
+
+	static void* Allocate(std::size_t size);
+	static void Deallocate(void* pointer, std::size_t size);
+};
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "DirtyRectRenderer.hpp"
+
+namespace
+{
+	SDL_Rect GetScreenRect(const Position& position, const Drawable& drawable)
+	{
+		return SDL_Rect{ static_cast<int>(position.x), static_cast<int>(position.y), drawable.width, drawable.height };
+	}
+}
+
+DirtyRectRenderer::DirtyRectRenderer(entt::registry& registry, SDLppRenderer& renderer, const SDL_Color& backgroundColor) :
+m_registry(registry),
+m_renderer(renderer),
+m_backgroundColor(backgroundColor),
+m_screenRect({ 0, 0, 0, 0 }),
+m_redrawnArea(0),
+m_redrawnRectCount(0),
+m_fullRedraw(true)
+{
+	// Une entité qui perd sa position ou son Drawable (ou est détruite) laisse un trou à combler
+	m_registry.on_destroy<Position>().connect<&DirtyRectRenderer::OnDestroy>(*this);
+	m_registry.on_destroy<Drawable>().connect<&DirtyRectRenderer::OnDestroy>(*this);
+}
+
+DirtyRectRenderer::~DirtyRectRenderer()
+{
+	m_registry.on_destroy<Position>().disconnect<&DirtyRectRenderer::OnDestroy>(*this);
+	m_registry.on_destroy<Drawable>().disconnect<&DirtyRectRenderer::OnDestroy>(*this);
+}
+
+std::size_t DirtyRectRenderer::GetRedrawnArea() const
+{
+	return m_redrawnArea;
+}
+
+std::size_t DirtyRectRenderer::GetRedrawnRectCount() const
+{
+	return m_redrawnRectCount;
+}
+
+void DirtyRectRenderer::Invalidate()
+{
+	m_fullRedraw = true;
+	m_dirtyRects.clear();
+}
+
+void DirtyRectRenderer::Invalidate(const SDL_Rect& rect)
+{
+	if (m_fullRedraw)
+		return;
+
+	SDL_Rect visibleRect;
+	if (SDL_IntersectRect(&rect, &m_screenRect, &visibleRect))
+		m_dirtyRects.push_back(visibleRect);
+}
+
+bool DirtyRectRenderer::Render()
+{
+	// La texture suit la taille de l'écran, son contenu initial n'étant pas défini tout est alors redessiné
+	int width, height;
+	SDL_GetRendererOutputSize(m_renderer.GetHandle(), &width, &height);
+	if (!m_target || width != m_screenRect.w || height != m_screenRect.h)
+	{
+		m_target = std::make_unique<SDLppRenderTarget>(m_renderer, width, height);
+
+		// La texture recouvre tout l'écran et est entièrement opaque : inutile de la mélanger à ce qui se trouve dessous
+		SDL_SetTextureBlendMode(m_target->GetTexture().GetHandle(), SDL_BLENDMODE_NONE);
+		m_screenRect = SDL_Rect{ 0, 0, width, height };
+		Invalidate();
+	}
+
+	// Comparaison de ce qui est affiché avec ce qui devrait l'être : une entité qui a bougé salit son ancienne et sa nouvelle position
+	auto view = m_registry.view<Position, Drawable>();
+	for (entt::entity entity : view)
+	{
+		const Drawable& entityDrawable = view.get<Drawable>(entity);
+		SDL_Rect rect = GetScreenRect(view.get<Position>(entity), entityDrawable);
+
+		if (!m_drawnStates.contains(entity))
+		{
+			m_drawnStates.emplace(entity, DrawnState{ rect, entityDrawable.texture, entityDrawable.sourceRect });
+			Invalidate(rect);
+			continue;
+		}
+
+		DrawnState& drawnState = m_drawnStates.get(entity);
+		if (!SDL_RectEquals(&drawnState.rect, &rect) || drawnState.texture.lock() != entityDrawable.texture || !SDL_RectEquals(&drawnState.sourceRect, &entityDrawable.sourceRect))
+		{
+			Invalidate(drawnState.rect);
+			Invalidate(rect);
+			drawnState = DrawnState{ rect, entityDrawable.texture, entityDrawable.sourceRect };
+		}
+	}
+
+	bool changed = m_fullRedraw || !m_dirtyRects.empty();
+	if (changed)
+	{
+		MergeDirtyRects();
+
+		m_renderer.SetTarget(*m_target);
+		m_renderer.SetDrawColor(m_backgroundColor.r, m_backgroundColor.g, m_backgroundColor.b, m_backgroundColor.a);
+
+		if (m_fullRedraw)
+		{
+			m_renderer.Clear();
+			for (entt::entity entity : view)
+				Draw(view.get<Drawable>(entity), m_drawnStates.get(entity).rect);
+
+			m_redrawnArea = static_cast<std::size_t>(width) * height;
+			m_redrawnRectCount = 1;
+		}
+		else
+		{
+			// Un seul parcours des entités pour répartir celles à redessiner entre les rectangles, dans l'ordre de la vue
+			// (celui de RenderSystem), puis chaque rectangle est effacé et redessiné en limitant l'affichage à celui-ci
+			m_rectEntities.resize(m_dirtyRects.size());
+			for (std::vector<entt::entity>& entities : m_rectEntities)
+				entities.clear();
+
+			for (entt::entity entity : view)
+			{
+				const SDL_Rect& rect = m_drawnStates.get(entity).rect;
+				for (std::size_t i = 0; i < m_dirtyRects.size(); ++i)
+				{
+					if (SDL_HasIntersection(&rect, &m_dirtyRects[i]))
+						m_rectEntities[i].push_back(entity);
+				}
+			}
+
+			m_redrawnArea = 0;
+			for (std::size_t i = 0; i < m_dirtyRects.size(); ++i)
+			{
+				m_renderer.SetClipRect(m_dirtyRects[i]);
+				m_renderer.FillRect(m_dirtyRects[i]);
+
+				for (entt::entity entity : m_rectEntities[i])
+					Draw(view.get<Drawable>(entity), m_drawnStates.get(entity).rect);
+
+				m_redrawnArea += static_cast<std::size_t>(m_dirtyRects[i].w) * m_dirtyRects[i].h;
+			}
+
+			m_redrawnRectCount = m_dirtyRects.size();
+			m_renderer.ResetClipRect();
+		}
+
+		m_renderer.ResetTarget();
+
+		m_dirtyRects.clear();
+		m_fullRedraw = false;
+	}
+	else
+	{
+		m_redrawnArea = 0;
+		m_redrawnRectCount = 0;
+	}
+
+	// Le contenu de l'écran n'est plus défini après Present : la texture y est recopiée à chaque frame
+	m_renderer.Copy(m_target->GetTexture());
+
+	return changed;
+}
+
+void DirtyRectRenderer::SetBackgroundColor(const SDL_Color& backgroundColor)
+{
+	m_backgroundColor = backgroundColor;
+	Invalidate();
+}
+
+void DirtyRectRenderer::Draw(const Drawable& drawable, const SDL_Rect& rect)
+{
+	if (SDL_RectEmpty(&drawable.sourceRect))
+		m_renderer.Copy(*drawable.texture, rect);
+	else
+		m_renderer.Copy(*drawable.texture, drawable.sourceRect, rect);
+}
+
+void DirtyRectRenderer::MergeDirtyRects()
+{
+	if (m_fullRedraw)
+		return;
+
+	// Trop de rectangles rendraient la fusion elle-même coûteuse : on se contente de leur englobant
+	if (m_dirtyRects.size() > MaxDirtyRects * MaxDirtyRects)
+	{
+		for (std::size_t i = 1; i < m_dirtyRects.size(); ++i)
+			SDL_UnionRect(&m_dirtyRects[0], &m_dirtyRects[i], &m_dirtyRects[0]);
+
+		m_dirtyRects.resize(1);
+	}
+
+	// Les rectangles qui se chevauchent sont fusionnés, ce qui peut en faire chevaucher d'autres : on recommence jusqu'à stabilité
+	bool merged;
+	do
+	{
+		merged = false;
+		for (std::size_t i = 0; i < m_dirtyRects.size(); ++i)
+		{
+			for (std::size_t j = i + 1; j < m_dirtyRects.size();)
+			{
+				if (SDL_HasIntersection(&m_dirtyRects[i], &m_dirtyRects[j]))
+				{
+					SDL_UnionRect(&m_dirtyRects[i], &m_dirtyRects[j], &m_dirtyRects[i]);
+					m_dirtyRects[j] = m_dirtyRects.back();
+					m_dirtyRects.pop_back();
+					merged = true;
+				}
+				else
+					++j;
+			}
+		}
+	}
+	while (merged);
+
+	if (m_dirtyRects.size() > MaxDirtyRects)
+	{
+		for (std::size_t i = 1; i < m_dirtyRects.size(); ++i)
+			SDL_UnionRect(&m_dirtyRects[0], &m_dirtyRects[i], &m_dirtyRects[0]);
+
+		m_dirtyRects.resize(1);
+	}
+
+	// Redessiner presque tout l'écran morceau par morceau coûterait plus cher qu'en une fois
+	std::size_t dirtyArea = 0;
+	for (const SDL_Rect& rect : m_dirtyRects)
+		dirtyArea += static_cast<std::size_t>(rect.w) * rect.h;
+
+	if (dirtyArea * 4 >= static_cast<std::size_t>(m_screenRect.w) * m_screenRect.h * 3)
+		Invalidate();
+}
+
+void DirtyRectRenderer::OnDestroy(entt::registry& /*registry*/, entt::entity entity)
+{
+	if (!m_drawnStates.contains(entity))
+		return;
+
+	Invalidate(m_drawnStates.get(entity).rect);
+	m_drawnStates.erase(entity);
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Components.hpp"
+#include "sdlcpp/SDLppRenderTarget.hpp"
+#include "sdlcpp/SDLppRenderer.hpp"
+#include "sdlcpp/SDLppTexture.hpp"
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Mode de rendu par "rectangles sales", alternative à Clear + RenderSystem pour les écrans presque immobiles (menus, éditeur) :
+// l'image est conservée d'une frame à l'autre dans une texture cible, et seules les zones où un Drawable est apparu,
+// a bougé, a changé ou a disparu y sont redessinées, avant que la texture ne soit copiée à l'écran en une fois.
+//
+// DirtyRectRenderer dirtyRects(registry, renderer);
+// ...
+// dirtyRects.Render();   // à la place de Clear + RenderSystem
+// renderer.Present();
+//
+// Les changements de Position et de Drawable sont détectés en comparant chaque frame le rectangle affiché à celui de la frame précédente ;
+// une texture dont le contenu change sans que le Drawable ne change doit être signalée avec Invalidate,
+// de même que la perte des textures cibles (événement SDL_RENDER_TARGETS_RESET).
+class DirtyRectRenderer
+{
+public:
+	DirtyRectRenderer(entt::registry& registry, SDLppRenderer& renderer, const SDL_Color& backgroundColor = { 0, 0, 0, 255 });
+	DirtyRectRenderer(const DirtyRectRenderer&) = delete;
+	DirtyRectRenderer(DirtyRectRenderer&&) = delete;
+	~DirtyRectRenderer();
+
+	std::size_t GetRedrawnArea() const;   //< En pixels, lors du dernier Render
+	std::size_t GetRedrawnRectCount() const;
+
+	// Force à redessiner tout l'écran, ou une zone seulement
+	void Invalidate();
+	void Invalidate(const SDL_Rect& rect);
+
+	// Met la texture à jour et la copie à l'écran, renvoie false si rien n'a changé depuis la frame précédente
+	bool Render();
+
+	void SetBackgroundColor(const SDL_Color& backgroundColor);
+
+	DirtyRectRenderer& operator=(const DirtyRectRenderer&) = delete;
+	DirtyRectRenderer& operator=(DirtyRectRenderer&&) = delete;
+
+	// Au-delà, les rectangles sont fusionnés en un seul
+	static constexpr std::size_t MaxDirtyRects = 16;
+
+private:
+	struct DrawnState
+	{
+		SDL_Rect rect;
+		std::weak_ptr<SDLppTexture> texture; //< Une texture détruite puis remplacée par une autre à la même adresse reste ainsi différente
+		SDL_Rect sourceRect;
+	};
+
+	void Draw(const Drawable& drawable, const SDL_Rect& rect);
+	void MergeDirtyRects();
+
+	void OnDestroy(entt::registry& registry, entt::entity entity);
+
+	std::unique_ptr<SDLppRenderTarget> m_target;
+	entt::storage<DrawnState> m_drawnStates; //< Ce qui est actuellement affiché dans m_target, indexé comme les pools du registre
+	std::vector<SDL_Rect> m_dirtyRects;
+	std::vector<std::vector<entt::entity>> m_rectEntities;
+	entt::registry& m_registry;
+	SDLppRenderer& m_renderer;
+	SDL_Color m_backgroundColor;
+	SDL_Rect m_screenRect;
+	std::size_t m_redrawnArea;
+	std::size_t m_redrawnRectCount;
+	bool m_fullRedraw;
+};
\ No newline at end of file
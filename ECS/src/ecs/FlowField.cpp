@@ -0,0 +1,308 @@
+#include "FlowField.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+FlowField::FlowField(unsigned int width, unsigned int height, float cellSize) :
+m_costs(static_cast<std::size_t>(width) * height, Unreachable),
+m_obstacles(static_cast<std::size_t>(width) * height, 0),
+m_cellSize(cellSize),
+m_goalX(0.f),
+m_goalY(0.f),
+m_goalCell(Unreachable),
+m_height(height),
+m_width(width)
+{
+	if (width == 0 || height == 0)
+		throw std::runtime_error("flow field cannot be empty");
+}
+
+float FlowField::GetCellSize() const
+{
+	return m_cellSize;
+}
+
+std::uint32_t FlowField::GetCost(unsigned int x, unsigned int y) const
+{
+	return m_costs[y * m_width + x];
+}
+
+unsigned int FlowField::GetHeight() const
+{
+	return m_height;
+}
+
+unsigned int FlowField::GetWidth() const
+{
+	return m_width;
+}
+
+bool FlowField::IsObstacle(unsigned int x, unsigned int y) const
+{
+	return m_obstacles[y * m_width + x] != 0;
+}
+
+bool FlowField::Sample(float x, float y, float& directionX, float& directionY) const
+{
+	std::uint32_t cell = GetCellIndex(x, y);
+	if (m_costs[cell] == Unreachable)
+		return false;
+
+	float targetX;
+	float targetY;
+	if (cell == m_goalCell)
+	{
+		// Dans la cellule de l'objectif, on se dirige directement vers celui-ci
+		targetX = m_goalX;
+		targetY = m_goalY;
+	}
+	else
+	{
+		// Sinon vers la cellule voisine la plus proche de l'objectif (diagonales comprises, tant qu'elles ne coupent pas un obstacle)
+		int cellX = static_cast<int>(cell % m_width);
+		int cellY = static_cast<int>(cell / m_width);
+
+		auto isFree = [&](int neighbourX, int neighbourY)
+		{
+			return neighbourX >= 0 && neighbourY >= 0 && neighbourX < static_cast<int>(m_width) && neighbourY < static_cast<int>(m_height) &&
+			       m_obstacles[neighbourY * m_width + neighbourX] == 0;
+		};
+
+		std::uint32_t bestCost = m_costs[cell];
+		int bestX = cellX;
+		int bestY = cellY;
+		for (int offsetY = -1; offsetY <= 1; ++offsetY)
+		{
+			for (int offsetX = -1; offsetX <= 1; ++offsetX)
+			{
+				int neighbourX = cellX + offsetX;
+				int neighbourY = cellY + offsetY;
+				if (!isFree(neighbourX, neighbourY))
+					continue;
+
+				if (offsetX != 0 && offsetY != 0 && (!isFree(cellX + offsetX, cellY) || !isFree(cellX, cellY + offsetY)))
+					continue;
+
+				std::uint32_t cost = m_costs[neighbourY * m_width + neighbourX];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestX = neighbourX;
+					bestY = neighbourY;
+				}
+			}
+		}
+
+		targetX = (static_cast<float>(bestX) + 0.5f) * m_cellSize;
+		targetY = (static_cast<float>(bestY) + 0.5f) * m_cellSize;
+	}
+
+	float dx = targetX - x;
+	float dy = targetY - y;
+	float length = std::sqrt(dx * dx + dy * dy);
+	if (length <= 0.f)
+	{
+		directionX = 0.f;
+		directionY = 0.f;
+	}
+	else
+	{
+		directionX = dx / length;
+		directionY = dy / length;
+	}
+
+	return true;
+}
+
+void FlowField::SetGoal(float x, float y)
+{
+	m_goalX = x;
+	m_goalY = y;
+
+	// Tant que l'objectif reste dans la même cellule, le champ d'intégration ne change pas
+	std::uint32_t goalCell = GetCellIndex(x, y);
+	if (goalCell == m_goalCell)
+		return;
+
+	m_goalCell = goalCell;
+	BuildIntegrationField();
+}
+
+void FlowField::SetObstacle(unsigned int x, unsigned int y, bool obstacle)
+{
+	std::uint32_t cell = y * m_width + x;
+	if ((m_obstacles[cell] != 0) == obstacle)
+		return;
+
+	m_obstacles[cell] = (obstacle) ? 1 : 0;
+
+	// Sans objectif, il n'y a pas encore de champ à mettre à jour
+	if (m_goalCell == Unreachable)
+		return;
+
+	// Un obstacle sur l'objectif rend tout inaccessible (et inversement), le plus simple est de tout recalculer
+	if (cell == m_goalCell)
+	{
+		BuildIntegrationField();
+		return;
+	}
+
+	auto forEachNeighbour = [&](std::uint32_t current, auto&& func)
+	{
+		std::uint32_t currentX = current % m_width;
+		std::uint32_t currentY = current / m_width;
+		if (currentX > 0)
+			func(current - 1);
+		if (currentX + 1 < m_width)
+			func(current + 1);
+		if (currentY > 0)
+			func(current - m_width);
+		if (currentY + 1 < m_height)
+			func(current + m_width);
+	};
+
+	CostQueue queue;
+
+	if (obstacle)
+	{
+		if (m_costs[cell] == Unreachable)
+			return;
+
+		// Les distances ne peuvent qu'augmenter : seules les cellules dont un plus court chemin passait par l'obstacle
+		// (celles qu'on atteint depuis l'obstacle en augmentant la distance de 1 à chaque pas) sont invalidées
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> pending = { { cell, m_costs[cell] } };
+		std::vector<std::uint32_t> invalidated;
+
+		m_costs[cell] = Unreachable;
+		while (!pending.empty())
+		{
+			auto [current, currentCost] = pending.back();
+			pending.pop_back();
+
+			forEachNeighbour(current, [&](std::uint32_t neighbour)
+			{
+				if (m_costs[neighbour] != Unreachable && m_costs[neighbour] == currentCost + 1)
+				{
+					pending.emplace_back(neighbour, m_costs[neighbour]);
+					invalidated.push_back(neighbour);
+					m_costs[neighbour] = Unreachable;
+				}
+			});
+		}
+
+		// Les cellules invalidées repartent de leurs voisines restées valides, puis on propage
+		for (std::uint32_t invalidCell : invalidated)
+		{
+			forEachNeighbour(invalidCell, [&](std::uint32_t neighbour)
+			{
+				if (m_obstacles[neighbour] == 0 && m_costs[neighbour] != Unreachable && m_costs[neighbour] + 1 < m_costs[invalidCell])
+					m_costs[invalidCell] = m_costs[neighbour] + 1;
+			});
+
+			if (m_costs[invalidCell] != Unreachable)
+				queue.emplace(m_costs[invalidCell], invalidCell);
+		}
+	}
+	else
+	{
+		// Les distances ne peuvent que diminuer : la cellule libérée repart de sa meilleure voisine, puis on propage
+		forEachNeighbour(cell, [&](std::uint32_t neighbour)
+		{
+			if (m_obstacles[neighbour] == 0 && m_costs[neighbour] != Unreachable && m_costs[neighbour] + 1 < m_costs[cell])
+				m_costs[cell] = m_costs[neighbour] + 1;
+		});
+
+		if (m_costs[cell] != Unreachable)
+			queue.emplace(m_costs[cell], cell);
+	}
+
+	Propagate(queue);
+}
+
+void FlowField::BuildIntegrationField()
+{
+	std::fill(m_costs.begin(), m_costs.end(), Unreachable);
+	if (m_obstacles[m_goalCell] != 0)
+		return;
+
+	// Toutes les cellules ont le même coût de traversée, un simple parcours en largeur suffit
+	std::vector<std::uint32_t> frontier = { m_goalCell };
+	std::vector<std::uint32_t> nextFrontier;
+	m_costs[m_goalCell] = 0;
+
+	std::uint32_t cost = 0;
+	while (!frontier.empty())
+	{
+		cost++;
+		nextFrontier.clear();
+
+		for (std::uint32_t current : frontier)
+		{
+			std::uint32_t currentX = current % m_width;
+			std::uint32_t currentY = current / m_width;
+
+			auto visit = [&](std::uint32_t neighbour)
+			{
+				if (m_obstacles[neighbour] == 0 && m_costs[neighbour] == Unreachable)
+				{
+					m_costs[neighbour] = cost;
+					nextFrontier.push_back(neighbour);
+				}
+			};
+
+			if (currentX > 0)
+				visit(current - 1);
+			if (currentX + 1 < m_width)
+				visit(current + 1);
+			if (currentY > 0)
+				visit(current - m_width);
+			if (currentY + 1 < m_height)
+				visit(current + m_width);
+		}
+
+		std::swap(frontier, nextFrontier);
+	}
+}
+
+std::uint32_t FlowField::GetCellIndex(float x, float y) const
+{
+	// Une position hors de la grille est ramenée à la cellule la plus proche
+	int cellX = std::clamp(static_cast<int>(std::floor(x / m_cellSize)), 0, static_cast<int>(m_width) - 1);
+	int cellY = std::clamp(static_cast<int>(std::floor(y / m_cellSize)), 0, static_cast<int>(m_height) - 1);
+
+	return static_cast<std::uint32_t>(cellY) * m_width + static_cast<std::uint32_t>(cellX);
+}
+
+void FlowField::Propagate(CostQueue& queue)
+{
+	// Dijkstra à partir des cellules mises à jour, en ne suivant que les voisines dont la distance s'améliore
+	while (!queue.empty())
+	{
+		auto [cost, current] = queue.top();
+		queue.pop();
+
+		if (cost > m_costs[current])
+			continue;
+
+		std::uint32_t currentX = current % m_width;
+		std::uint32_t currentY = current / m_width;
+
+		auto relax = [&](std::uint32_t neighbour)
+		{
+			if (m_obstacles[neighbour] == 0 && cost + 1 < m_costs[neighbour])
+			{
+				m_costs[neighbour] = cost + 1;
+				queue.emplace(cost + 1, neighbour);
+			}
+		};
+
+		if (currentX > 0)
+			relax(current - 1);
+		if (currentX + 1 < m_width)
+			relax(current + 1);
+		if (currentY > 0)
+			relax(current - m_width);
+		if (currentY + 1 < m_height)
+			relax(current + m_width);
+	}
+}
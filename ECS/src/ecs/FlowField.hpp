@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Champ de flux (flow field) vers un objectif : plutôt que de chercher un chemin pour chaque agent (A*),
+// on calcule une seule fois, depuis l'objectif, la distance de chaque cellule de la grille à celui-ci (champ d'intégration).
+// Un agent n'a plus qu'à regarder ses cellules voisines pour savoir dans quelle direction aller, en O(1).
+// Le champ n'est recalculé que si l'objectif change de cellule, et un obstacle ajouté ou retiré
+// ne met à jour que les cellules dont la distance change.
+class FlowField
+{
+public:
+	FlowField(unsigned int width, unsigned int height, float cellSize);
+	FlowField(const FlowField&) = default;
+	FlowField(FlowField&&) = default;
+	~FlowField() = default;
+
+	float GetCellSize() const;
+	std::uint32_t GetCost(unsigned int x, unsigned int y) const;
+	unsigned int GetHeight() const;
+	unsigned int GetWidth() const;
+
+	bool IsObstacle(unsigned int x, unsigned int y) const;
+
+	bool Sample(float x, float y, float& directionX, float& directionY) const;
+
+	void SetGoal(float x, float y);
+	void SetObstacle(unsigned int x, unsigned int y, bool obstacle);
+
+	FlowField& operator=(const FlowField&) = default;
+	FlowField& operator=(FlowField&&) = default;
+
+	static constexpr std::uint32_t Unreachable = UINT32_MAX;
+
+private:
+	using CostQueue = std::priority_queue<std::pair<std::uint32_t, std::uint32_t>, std::vector<std::pair<std::uint32_t, std::uint32_t>>, std::greater<>>;
+
+	void BuildIntegrationField();
+	std::uint32_t GetCellIndex(float x, float y) const;
+	void Propagate(CostQueue& queue);
+
+	std::vector<std::uint32_t> m_costs;
+	std::vector<std::uint8_t> m_obstacles;
+	float m_cellSize;
+	float m_goalX;
+	float m_goalY;
+	std::uint32_t m_goalCell;
+	unsigned int m_height;
+	unsigned int m_width;
+};
\ No newline at end of file
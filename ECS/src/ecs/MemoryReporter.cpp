@@ -0,0 +1,60 @@
+#include "MemoryReporter.hpp"
+#include <iomanip>
+#include <ostream>
+
+std::size_t MemoryReporter::Compact(entt::registry& registry) const
+{
+	std::size_t bytesBefore = 0;
+	std::size_t bytesAfter = 0;
+
+	PoolMemoryUsage usage;
+	for (const Pool& pool : m_pools)
+	{
+		pool.report(registry, usage);
+		bytesBefore += usage.bytes;
+
+		pool.compact(registry);
+
+		pool.report(registry, usage);
+		bytesAfter += usage.bytes;
+	}
+
+	return bytesBefore - bytesAfter;
+}
+
+std::vector<PoolMemoryUsage> MemoryReporter::Report(entt::registry& registry) const
+{
+	std::vector<PoolMemoryUsage> report;
+	report.reserve(m_pools.size());
+
+	for (const Pool& pool : m_pools)
+	{
+		PoolMemoryUsage& usage = report.emplace_back();
+		usage.name = pool.name;
+		pool.report(registry, usage);
+	}
+
+	return report;
+}
+
+void MemoryReporter::Print(std::ostream& stream, const std::vector<PoolMemoryUsage>& report)
+{
+	std::size_t totalBytes = 0;
+	std::size_t totalUsedBytes = 0;
+
+	stream << std::left << std::setw(20) << "Pool" << std::right << std::setw(12) << "Size" << std::setw(12) << "Capacity" << std::setw(12) << "Sparse" << std::setw(12) << "KiB" << std::setw(12) << "Unused" << '\n';
+	for (const PoolMemoryUsage& usage : report)
+	{
+		stream << std::left << std::setw(20) << usage.name << std::right;
+		stream << std::setw(12) << usage.size;
+		stream << std::setw(12) << usage.capacity;
+		stream << std::setw(12) << usage.sparseExtent;
+		stream << std::setw(12) << usage.bytes / 1024;
+		stream << std::setw(11) << std::fixed << std::setprecision(1) << usage.fragmentation * 100.f << "%\n";
+
+		totalBytes += usage.bytes;
+		totalUsedBytes += usage.usedBytes;
+	}
+
+	stream << "Total: " << totalBytes / 1024 << " KiB (" << (totalBytes - totalUsedBytes) / 1024 << " KiB unused)" << std::endl;
+}
\ No newline at end of file
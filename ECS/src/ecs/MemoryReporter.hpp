@@ -0,0 +1,91 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Occupation mémoire d'un pool de composants
+struct PoolMemoryUsage
+{
+	std::string name;
+	std::size_t size;         //< Nombre de composants vivants
+	std::size_t capacity;     //< Nombre de composants que le pool peut accueillir sans réallouer
+	std::size_t sparseExtent; //< Nombre d'entrées du tableau sparse (indexé par identifiant d'entité)
+	std::size_t bytes;        //< Mémoire réservée par le pool (dense + sparse)
+	std::size_t usedBytes;    //< Partie de cette mémoire réellement occupée par des composants vivants
+	float fragmentation;      //< Part de la mémoire du pool inutilisée (0 = pool plein, 1 = pool vide)
+};
+
+// Rapporte l'occupation mémoire des pools d'un registre, et permet de les compacter
+//
+// Détruire des entités ne libère pas la mémoire de leurs pools : après une grosse vague de disparition,
+// les pools gardent leur capacité maximale. Compact rend cette capacité morte au système.
+// Comme pour le WorldCloner, seuls les types de composants enregistrés sont concernés (il faut connaître leur taille).
+class MemoryReporter
+{
+public:
+	MemoryReporter() = default;
+	MemoryReporter(const MemoryReporter&) = default;
+	MemoryReporter(MemoryReporter&&) = default;
+	~MemoryReporter() = default;
+
+	std::size_t Compact(entt::registry& registry) const;
+
+	template<typename Component> void Register(std::string name);
+
+	std::vector<PoolMemoryUsage> Report(entt::registry& registry) const;
+
+	MemoryReporter& operator=(const MemoryReporter&) = default;
+	MemoryReporter& operator=(MemoryReporter&&) = default;
+
+	static void Print(std::ostream& stream, const std::vector<PoolMemoryUsage>& report);
+
+private:
+	template<typename Component> static void CompactPool(entt::registry& registry);
+	template<typename Component> static void ReportPool(entt::registry& registry, PoolMemoryUsage& usage);
+
+	struct Pool
+	{
+		std::string name;
+		void(*compact)(entt::registry& registry);
+		void(*report)(entt::registry& registry, PoolMemoryUsage& usage);
+	};
+
+	std::vector<Pool> m_pools;
+};
+
+template<typename Component>
+void MemoryReporter::Register(std::string name)
+{
+	Pool& pool = m_pools.emplace_back();
+	pool.name = std::move(name);
+	pool.compact = &CompactPool<Component>;
+	pool.report = &ReportPool<Component>;
+}
+
+template<typename Component>
+void MemoryReporter::CompactPool(entt::registry& registry)
+{
+	// Rend les pages de composants inutilisées ainsi que les pages sparse vides
+	registry.storage<Component>().shrink_to_fit();
+}
+
+template<typename Component>
+void MemoryReporter::ReportPool(entt::registry& registry, PoolMemoryUsage& usage)
+{
+	auto& storage = registry.storage<Component>();
+
+	// Les composants vides (tags) n'ont pas de stockage propre, seuls les identifiants d'entités sont conservés
+	constexpr std::size_t ElementSize = sizeof(entt::entity) + (std::is_empty_v<Component> ? 0 : sizeof(Component));
+
+	usage.size = storage.size();
+	usage.capacity = storage.capacity();
+	usage.sparseExtent = storage.extent();
+	usage.bytes = usage.capacity * ElementSize + usage.sparseExtent * sizeof(entt::entity);
+	usage.usedBytes = usage.size * ElementSize;
+	usage.fragmentation = (usage.bytes > 0) ? 1.f - static_cast<float>(usage.usedBytes) / usage.bytes : 0.f;
+}
\ No newline at end of file
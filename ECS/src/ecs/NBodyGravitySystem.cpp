@@ -0,0 +1,334 @@
+#include "NBodyGravitySystem.hpp"
+#include "Components.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+	// Nombre maximal de corps dans une feuille du quadtree, en dessous duquel on ne subdivise plus
+	constexpr std::uint32_t LeafSize = 16;
+	// Les codes de Morton sont sur 32 bits (16 bits par axe), ce qui limite la profondeur de l'arbre
+	constexpr unsigned int MaxDepth = 16;
+
+	// Intercale des zéros entre les 16 bits de poids faible de value (0b1011 => 0b01000101)
+	std::uint32_t SpreadBits(std::uint32_t value)
+	{
+		value &= 0x0000FFFF;
+		value = (value | (value << 8)) & 0x00FF00FF;
+		value = (value | (value << 4)) & 0x0F0F0F0F;
+		value = (value | (value << 2)) & 0x33333333;
+		value = (value | (value << 1)) & 0x55555555;
+
+		return value;
+	}
+}
+
+NBodyGravitySystem::NBodyGravitySystem(ThreadPool& threadPool, float gravitationalConstant, float openingAngle, float softening) :
+m_threadPool(threadPool),
+m_gravitationalConstant(gravitationalConstant),
+m_openingAngle(openingAngle),
+m_softening(softening)
+{
+}
+
+float NBodyGravitySystem::GetOpeningAngle() const
+{
+	return m_openingAngle;
+}
+
+void NBodyGravitySystem::SetOpeningAngle(float openingAngle)
+{
+	m_openingAngle = openingAngle;
+}
+
+void NBodyGravitySystem::Update(entt::registry& registry, float elapsedTime)
+{
+	// On recopie les corps dans des tableaux contigus (les vecteurs gardent leur capacité d'un tick à l'autre)
+	m_entities.clear();
+	m_unsortedMass.clear();
+	m_unsortedX.clear();
+	m_unsortedY.clear();
+
+	auto view = registry.view<Position, Mass>();
+	for (entt::entity entity : view)
+	{
+		auto& entityPos = view.get<Position>(entity);
+		auto& entityMass = view.get<Mass>(entity);
+
+		m_entities.push_back(entity);
+		m_unsortedMass.push_back(entityMass.value);
+		m_unsortedX.push_back(entityPos.x);
+		m_unsortedY.push_back(entityPos.y);
+	}
+
+	if (m_entities.empty())
+		return;
+
+	BuildTree();
+
+	// La pool des vélocités est récupérée (et créée si besoin) avant de lancer les threads, qui ne doivent pas modifier le registre
+	auto& velocities = registry.storage<Velocity>();
+
+	// Chaque feuille calcule l'accélération de ses corps indépendamment des autres, on les répartit donc entre les threads.
+	// Les feuilles sont rangées dans l'ordre spatial : une tranche contiguë parcourt à peu près les mêmes noeuds, ce qui est bon pour le cache
+	m_threadPool.ParallelFor(m_leaves.size(), 16, [&](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			ComputeLeafAccelerations(m_leaves[i]);
+
+			const Node& leaf = m_nodes[m_leaves[i]];
+			for (std::uint32_t body = leaf.firstBody; body < leaf.firstBody + leaf.bodyCount; ++body)
+			{
+				entt::entity entity = m_sortedEntities[body];
+				if (velocities.contains(entity))
+				{
+					Velocity& entityVel = velocities.get(entity);
+					entityVel.x += m_accelX[body] * elapsedTime;
+					entityVel.y += m_accelY[body] * elapsedTime;
+				}
+			}
+		}
+	});
+}
+
+void NBodyGravitySystem::BuildNode(std::uint32_t nodeIndex, std::uint32_t firstBody, std::uint32_t bodyCount, unsigned int depth, float size)
+{
+	// Attention : m_nodes peut être réalloué par les appels récursifs, on ne garde donc pas de référence sur un noeud
+	m_nodes[nodeIndex].size = size;
+	m_nodes[nodeIndex].firstBody = firstBody;
+	m_nodes[nodeIndex].bodyCount = bodyCount;
+	m_nodes[nodeIndex].firstChild = 0;
+	m_nodes[nodeIndex].childCount = 0;
+
+	float mass = 0.f;
+	float massCenterX = 0.f;
+	float massCenterY = 0.f;
+
+	if (bodyCount <= LeafSize || depth >= MaxDepth)
+	{
+		m_leaves.push_back(nodeIndex);
+
+		for (std::uint32_t i = firstBody; i < firstBody + bodyCount; ++i)
+		{
+			mass += m_bodyMass[i];
+			massCenterX += m_bodyX[i] * m_bodyMass[i];
+			massCenterY += m_bodyY[i] * m_bodyMass[i];
+		}
+	}
+	else
+	{
+		// Les corps étant triés par code de Morton, ceux d'un même quadrant sont contigus :
+		// il suffit de chercher où change la paire de bits correspondant à cette profondeur
+		unsigned int shift = 30 - 2 * depth;
+		auto quadrantOf = [&](std::uint32_t body) { return (m_sortEntries[body].code >> shift) & 3; };
+
+		std::array<std::pair<std::uint32_t, std::uint32_t>, 4> childRanges;
+		std::uint32_t childCount = 0;
+
+		std::uint32_t rangeStart = firstBody;
+		std::uint32_t end = firstBody + bodyCount;
+		while (rangeStart < end)
+		{
+			std::uint32_t quadrant = quadrantOf(rangeStart);
+			std::uint32_t rangeEnd = rangeStart + 1;
+			while (rangeEnd < end && quadrantOf(rangeEnd) == quadrant)
+				rangeEnd++;
+
+			childRanges[childCount++] = { rangeStart, rangeEnd - rangeStart };
+			rangeStart = rangeEnd;
+		}
+
+		std::uint32_t firstChild = static_cast<std::uint32_t>(m_nodes.size());
+		m_nodes.resize(m_nodes.size() + childCount);
+		m_nodes[nodeIndex].firstChild = firstChild;
+		m_nodes[nodeIndex].childCount = childCount;
+
+		for (std::uint32_t i = 0; i < childCount; ++i)
+		{
+			BuildNode(firstChild + i, childRanges[i].first, childRanges[i].second, depth + 1, size * 0.5f);
+
+			const Node& child = m_nodes[firstChild + i];
+			mass += child.mass;
+			massCenterX += child.massCenterX * child.mass;
+			massCenterY += child.massCenterY * child.mass;
+		}
+	}
+
+	Node& node = m_nodes[nodeIndex];
+	node.mass = mass;
+	node.massCenterX = (mass > 0.f) ? massCenterX / mass : 0.f;
+	node.massCenterY = (mass > 0.f) ? massCenterY / mass : 0.f;
+}
+
+void NBodyGravitySystem::BuildTree()
+{
+	std::size_t bodyCount = m_entities.size();
+
+	float minX = *std::min_element(m_unsortedX.begin(), m_unsortedX.end());
+	float maxX = *std::max_element(m_unsortedX.begin(), m_unsortedX.end());
+	float minY = *std::min_element(m_unsortedY.begin(), m_unsortedY.end());
+	float maxY = *std::max_element(m_unsortedY.begin(), m_unsortedY.end());
+
+	// La racine est un carré englobant tous les corps
+	float rootSize = std::max({ maxX - minX, maxY - minY, 1.f });
+	float scale = 65535.f / rootSize;
+
+	m_sortEntries.resize(bodyCount);
+	for (std::size_t i = 0; i < bodyCount; ++i)
+	{
+		auto gridX = static_cast<std::uint32_t>(std::min((m_unsortedX[i] - minX) * scale, 65535.f));
+		auto gridY = static_cast<std::uint32_t>(std::min((m_unsortedY[i] - minY) * scale, 65535.f));
+
+		m_sortEntries[i].code = SpreadBits(gridX) | (SpreadBits(gridY) << 1);
+		m_sortEntries[i].index = static_cast<std::uint32_t>(i);
+	}
+
+	SortBodies();
+
+	m_accelX.resize(bodyCount);
+	m_accelY.resize(bodyCount);
+	m_bodyMass.resize(bodyCount);
+	m_bodyX.resize(bodyCount);
+	m_bodyY.resize(bodyCount);
+	m_sortedEntities.resize(bodyCount);
+	for (std::size_t i = 0; i < bodyCount; ++i)
+	{
+		std::uint32_t index = m_sortEntries[i].index;
+		m_bodyMass[i] = m_unsortedMass[index];
+		m_bodyX[i] = m_unsortedX[index];
+		m_bodyY[i] = m_unsortedY[index];
+		m_sortedEntities[i] = m_entities[index];
+	}
+
+	m_leaves.clear();
+	m_nodes.clear();
+	m_nodes.emplace_back();
+	BuildNode(0, 0, static_cast<std::uint32_t>(bodyCount), 0, rootSize);
+}
+
+void NBodyGravitySystem::ComputeLeafAccelerations(std::uint32_t leafIndex)
+{
+	const Node& leaf = m_nodes[leafIndex];
+
+	// Boîte englobante des corps de la feuille
+	float minX = m_bodyX[leaf.firstBody];
+	float maxX = minX;
+	float minY = m_bodyY[leaf.firstBody];
+	float maxY = minY;
+	for (std::uint32_t i = leaf.firstBody + 1; i < leaf.firstBody + leaf.bodyCount; ++i)
+	{
+		minX = std::min(minX, m_bodyX[i]);
+		maxX = std::max(maxX, m_bodyX[i]);
+		minY = std::min(minY, m_bodyY[i]);
+		maxY = std::max(maxY, m_bodyY[i]);
+	}
+
+	float openingAngleSq = m_openingAngle * m_openingAngle;
+	float softeningSq = m_softening * m_softening;
+
+	// Plutôt que de parcourir l'arbre pour chaque corps, on le parcourt une seule fois pour toute la feuille
+	// en mesurant la distance à sa boîte englobante, et on en tire une liste d'interactions (centres de masse
+	// et corps proches) commune à tous ses corps. Les listes sont propres à chaque thread et réutilisées d'une feuille à l'autre
+	thread_local std::vector<float> interactionMass;
+	thread_local std::vector<float> interactionX;
+	thread_local std::vector<float> interactionY;
+	interactionMass.clear();
+	interactionX.clear();
+	interactionY.clear();
+
+	// Parcours de l'arbre sans récursion : chaque niveau empile au plus 4 enfants
+	std::array<std::uint32_t, 4 * MaxDepth + 4> stack;
+	std::size_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const Node& node = m_nodes[stack[--stackSize]];
+
+		float dx = std::max({ minX - node.massCenterX, 0.f, node.massCenterX - maxX });
+		float dy = std::max({ minY - node.massCenterY, 0.f, node.massCenterY - maxY });
+
+		// Un ancêtre de la feuille (dont les corps contiennent ceux de la feuille) n'est jamais approximé : son centre de masse
+		// peut être loin de la feuille, mais les corps de celle-ci s'attireraient alors eux-mêmes à travers lui
+		bool containsLeaf = node.firstBody <= leaf.firstBody && leaf.firstBody < node.firstBody + node.bodyCount;
+
+		// Critère de Barnes-Hut : le noeud est assez loin de tous les corps de la feuille pour être assimilé à son centre de masse
+		if (!containsLeaf && node.size * node.size < openingAngleSq * (dx * dx + dy * dy))
+		{
+			interactionMass.push_back(node.mass);
+			interactionX.push_back(node.massCenterX);
+			interactionY.push_back(node.massCenterY);
+		}
+		else if (node.childCount == 0)
+		{
+			// Feuille trop proche : chacun de ses corps interagit directement (y compris la feuille elle-même,
+			// l'attraction d'un corps sur lui-même étant nulle puisque leur distance l'est)
+			for (std::uint32_t i = node.firstBody; i < node.firstBody + node.bodyCount; ++i)
+			{
+				interactionMass.push_back(m_bodyMass[i]);
+				interactionX.push_back(m_bodyX[i]);
+				interactionY.push_back(m_bodyY[i]);
+			}
+		}
+		else
+		{
+			for (std::uint32_t i = 0; i < node.childCount; ++i)
+				stack[stackSize++] = node.firstChild + i;
+		}
+	}
+
+	// Boucle simple sur des tableaux contigus, que le compilateur peut vectoriser
+	std::size_t interactionCount = interactionMass.size();
+	for (std::uint32_t body = leaf.firstBody; body < leaf.firstBody + leaf.bodyCount; ++body)
+	{
+		float bodyX = m_bodyX[body];
+		float bodyY = m_bodyY[body];
+
+		float accelX = 0.f;
+		float accelY = 0.f;
+		for (std::size_t i = 0; i < interactionCount; ++i)
+		{
+			float dx = interactionX[i] - bodyX;
+			float dy = interactionY[i] - bodyY;
+			float distSq = dx * dx + dy * dy + softeningSq;
+
+			float invDist = 1.f / std::sqrt(distSq);
+			float factor = interactionMass[i] * invDist * invDist * invDist;
+			accelX += dx * factor;
+			accelY += dy * factor;
+		}
+
+		m_accelX[body] = accelX * m_gravitationalConstant;
+		m_accelY[body] = accelY * m_gravitationalConstant;
+	}
+}
+
+void NBodyGravitySystem::SortBodies()
+{
+	// Tri par base (radix sort) des codes de Morton, octet par octet : linéaire en nombre de corps,
+	// contrairement à un tri par comparaison
+	m_sortBuffer.resize(m_sortEntries.size());
+
+	for (unsigned int shift = 0; shift < 32; shift += 8)
+	{
+		std::array<std::uint32_t, 256> offsets = {};
+		for (const SortEntry& entry : m_sortEntries)
+			offsets[(entry.code >> shift) & 0xFF]++;
+
+		std::uint32_t offset = 0;
+		for (std::uint32_t& count : offsets)
+		{
+			std::uint32_t bucketSize = count;
+			count = offset;
+			offset += bucketSize;
+		}
+
+		for (const SortEntry& entry : m_sortEntries)
+			m_sortBuffer[offsets[(entry.code >> shift) & 0xFF]++] = entry;
+
+		std::swap(m_sortEntries, m_sortBuffer);
+	}
+}
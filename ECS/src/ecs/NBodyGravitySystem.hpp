@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ThreadPool.hpp"
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Attraction gravitationnelle mutuelle entre toutes les entités ayant une Position et une Mass,
+// approximée par l'algorithme de Barnes-Hut : les corps sont rangés dans un quadtree reconstruit à chaque tick,
+// et un groupe de corps suffisamment lointain (taille du noeud / distance < angle d'ouverture) est traité comme un seul corps
+// situé à son centre de masse. On passe ainsi de O(n²) à O(n log n).
+// Seules les entités ayant aussi une Velocity sont accélérées, les autres ne sont que des attracteurs fixes.
+class NBodyGravitySystem
+{
+public:
+	NBodyGravitySystem(ThreadPool& threadPool, float gravitationalConstant, float openingAngle = 0.5f, float softening = 1.f);
+	NBodyGravitySystem(const NBodyGravitySystem&) = delete;
+	NBodyGravitySystem(NBodyGravitySystem&&) = delete;
+	~NBodyGravitySystem() = default;
+
+	float GetOpeningAngle() const;
+
+	void SetOpeningAngle(float openingAngle);
+
+	void Update(entt::registry& registry, float elapsedTime);
+
+	NBodyGravitySystem& operator=(const NBodyGravitySystem&) = delete;
+	NBodyGravitySystem& operator=(NBodyGravitySystem&&) = delete;
+
+private:
+	struct Node
+	{
+		float massCenterX;
+		float massCenterY;
+		float mass;
+		float size;
+		std::uint32_t firstChild;
+		std::uint32_t childCount;
+		std::uint32_t firstBody;
+		std::uint32_t bodyCount;
+	};
+
+	struct SortEntry
+	{
+		std::uint32_t code;
+		std::uint32_t index;
+	};
+
+	void BuildNode(std::uint32_t nodeIndex, std::uint32_t firstBody, std::uint32_t bodyCount, unsigned int depth, float size);
+	void BuildTree();
+	void ComputeLeafAccelerations(std::uint32_t leafIndex);
+	void SortBodies();
+
+	std::vector<entt::entity> m_entities;
+	std::vector<entt::entity> m_sortedEntities;
+	std::vector<float> m_accelX;
+	std::vector<float> m_accelY;
+	std::vector<float> m_bodyMass;
+	std::vector<float> m_bodyX;
+	std::vector<float> m_bodyY;
+	std::vector<float> m_unsortedMass;
+	std::vector<float> m_unsortedX;
+	std::vector<float> m_unsortedY;
+	std::vector<Node> m_nodes;
+	std::vector<std::uint32_t> m_leaves;
+	std::vector<SortEntry> m_sortBuffer;
+	std::vector<SortEntry> m_sortEntries;
+	ThreadPool& m_threadPool;
+	float m_gravitationalConstant;
+	float m_openingAngle;
+	float m_softening;
+};
\ No newline at end of file
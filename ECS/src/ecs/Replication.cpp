@@ -0,0 +1,547 @@
+#include "Replication.hpp"
+#include "Components.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+	enum class PacketType : std::uint8_t
+	{
+		Snapshot,
+		Ack
+	};
+
+	constexpr float PositionPrecision = 16.f;
+	constexpr float VelocityPrecision = 8.f;
+	constexpr std::size_t FieldCount = 4;
+
+	// Les fragments restent sous la MTU usuelle pour ne pas être eux-mêmes fragmentés par IP
+	constexpr std::size_t FragmentPayloadSize = 1200;
+	constexpr std::size_t SnapshotHeaderSize = 10;
+
+	// Comparaison de numéros de séquence tenant compte du rebouclage sur 16 bits
+	bool IsSequenceNewer(std::uint16_t sequence, std::uint16_t reference)
+	{
+		return static_cast<std::int16_t>(sequence - reference) > 0;
+	}
+
+	void WriteU16(std::uint8_t* buffer, std::uint16_t value)
+	{
+		buffer[0] = static_cast<std::uint8_t>(value);
+		buffer[1] = static_cast<std::uint8_t>(value >> 8);
+	}
+
+	std::uint16_t ReadU16(const std::uint8_t* buffer)
+	{
+		return static_cast<std::uint16_t>(buffer[0] | (buffer[1] << 8));
+	}
+
+	std::int32_t Quantize(float value, float precision)
+	{
+		return static_cast<std::int32_t>(std::lround(value * precision));
+	}
+
+	// Un écart est codé en zigzag (les petits écarts négatifs deviennent de petits entiers positifs)
+	// sur 4, 8, 16 ou 32 bits, la taille étant annoncée sur 2 bits
+	void WriteDelta(BitWriter& writer, std::int32_t value, std::int32_t reference)
+	{
+		std::uint32_t delta = static_cast<std::uint32_t>(value) - static_cast<std::uint32_t>(reference);
+		std::uint32_t zigzag = (delta << 1) ^ static_cast<std::uint32_t>(static_cast<std::int32_t>(delta) >> 31);
+
+		if (zigzag < (1u << 4))
+		{
+			writer.WriteBits(0, 2);
+			writer.WriteBits(zigzag, 4);
+		}
+		else if (zigzag < (1u << 8))
+		{
+			writer.WriteBits(1, 2);
+			writer.WriteBits(zigzag, 8);
+		}
+		else if (zigzag < (1u << 16))
+		{
+			writer.WriteBits(2, 2);
+			writer.WriteBits(zigzag, 16);
+		}
+		else
+		{
+			writer.WriteBits(3, 2);
+			writer.WriteBits(zigzag, 32);
+		}
+	}
+
+	std::int32_t ReadDelta(BitReader& reader, std::int32_t reference)
+	{
+		constexpr unsigned int SizeClasses[] = { 4, 8, 16, 32 };
+
+		std::uint32_t zigzag = reader.ReadBits(SizeClasses[reader.ReadBits(2)]);
+		std::uint32_t delta = (zigzag >> 1) ^ (0u - (zigzag & 1));
+
+		return static_cast<std::int32_t>(static_cast<std::uint32_t>(reference) + delta);
+	}
+
+	void WriteState(BitWriter& writer, const ReplicatedState& state, const std::int32_t* reference)
+	{
+		std::uint32_t mask = 0;
+		for (std::size_t i = 0; i < FieldCount; ++i)
+		{
+			if (state.values[i] != reference[i])
+				mask |= 1u << i;
+		}
+
+		writer.WriteBits(mask, FieldCount);
+		for (std::size_t i = 0; i < FieldCount; ++i)
+		{
+			if (mask & (1u << i))
+				WriteDelta(writer, state.values[i], reference[i]);
+		}
+	}
+
+	void ReadState(BitReader& reader, ReplicatedState& state, const std::int32_t* reference)
+	{
+		std::uint32_t mask = reader.ReadBits(FieldCount);
+		for (std::size_t i = 0; i < FieldCount; ++i)
+			state.values[i] = (mask & (1u << i)) ? ReadDelta(reader, reference[i]) : reference[i];
+	}
+
+	// Les deux snapshots sont triés par identifiant, ce qui permet de les comparer en un seul parcours
+	void EncodeDelta(BitWriter& writer, const ReplicationSnapshot& baseline, const ReplicationSnapshot& snapshot)
+	{
+		static constexpr std::int32_t Zero[FieldCount] = {};
+
+		std::vector<std::uint32_t> removedIds;
+		std::vector<std::pair<const ReplicatedState*, const ReplicatedState*>> changedStates; //< (état, état de référence ou nullptr)
+
+		std::size_t baselineIndex = 0;
+		for (const ReplicatedState& state : snapshot)
+		{
+			while (baselineIndex < baseline.size() && baseline[baselineIndex].id < state.id)
+				removedIds.push_back(baseline[baselineIndex++].id);
+
+			if (baselineIndex < baseline.size() && baseline[baselineIndex].id == state.id)
+			{
+				const ReplicatedState& reference = baseline[baselineIndex++];
+				if (!std::equal(std::begin(state.values), std::end(state.values), std::begin(reference.values)))
+					changedStates.emplace_back(&state, &reference);
+			}
+			else
+				changedStates.emplace_back(&state, nullptr);
+		}
+
+		while (baselineIndex < baseline.size())
+			removedIds.push_back(baseline[baselineIndex++].id);
+
+		// Les identifiants sont croissants : on n'écrit que l'écart avec le précédent
+		std::uint32_t previousId = 0;
+		writer.WriteVarUInt(static_cast<std::uint32_t>(removedIds.size()));
+		for (std::uint32_t id : removedIds)
+		{
+			writer.WriteVarUInt(id - previousId);
+			previousId = id;
+		}
+
+		previousId = 0;
+		writer.WriteVarUInt(static_cast<std::uint32_t>(changedStates.size()));
+		for (const auto& [state, reference] : changedStates)
+		{
+			writer.WriteVarUInt(state->id - previousId);
+			previousId = state->id;
+
+			writer.WriteBits(reference ? 0 : 1, 1);
+			WriteState(writer, *state, reference ? reference->values : Zero);
+		}
+	}
+
+	void DecodeDelta(BitReader& reader, const ReplicationSnapshot& baseline, ReplicationSnapshot& snapshot)
+	{
+		static constexpr std::int32_t Zero[FieldCount] = {};
+
+		std::vector<std::uint32_t> removedIds(reader.ReadVarUInt());
+		std::uint32_t previousId = 0;
+		for (std::uint32_t& id : removedIds)
+		{
+			id = previousId + reader.ReadVarUInt();
+			previousId = id;
+		}
+
+		snapshot.clear();
+		snapshot.reserve(baseline.size());
+
+		std::size_t baselineIndex = 0;
+		std::size_t removedIndex = 0;
+
+		// Recopie les entités de référence d'identifiant inférieur à maxId, sauf celles ayant disparu
+		auto CopyBaselineUntil = [&](std::uint32_t maxId)
+		{
+			while (baselineIndex < baseline.size() && baseline[baselineIndex].id < maxId)
+			{
+				const ReplicatedState& reference = baseline[baselineIndex++];
+				while (removedIndex < removedIds.size() && removedIds[removedIndex] < reference.id)
+					removedIndex++;
+
+				if (removedIndex < removedIds.size() && removedIds[removedIndex] == reference.id)
+					continue;
+
+				snapshot.push_back(reference);
+			}
+		};
+
+		std::uint32_t changedCount = reader.ReadVarUInt();
+		previousId = 0;
+		for (std::uint32_t i = 0; i < changedCount; ++i)
+		{
+			ReplicatedState state;
+			state.id = previousId + reader.ReadVarUInt();
+			previousId = state.id;
+
+			bool isNew = reader.ReadBits(1) != 0;
+
+			CopyBaselineUntil(state.id);
+			if (isNew)
+				ReadState(reader, state, Zero);
+			else
+			{
+				if (baselineIndex >= baseline.size() || baseline[baselineIndex].id != state.id)
+					throw std::runtime_error("replicated entity is missing from the baseline");
+
+				ReadState(reader, state, baseline[baselineIndex++].values);
+			}
+
+			snapshot.push_back(state);
+		}
+
+		// entt::null n'est jamais l'identifiant d'une entité valide, il sert de borne
+		CopyBaselineUntil(entt::to_integral(entt::entity(entt::null)));
+	}
+}
+
+ReplicationServer::ReplicationServer(UdpSocket& socket) :
+m_socket(socket),
+m_ackSequence(0),
+m_sequence(0),
+m_hasAck(false),
+m_hasClient(false)
+{
+}
+
+std::uint16_t ReplicationServer::GetSequence() const
+{
+	return m_sequence;
+}
+
+bool ReplicationServer::HasClient() const
+{
+	return m_hasClient;
+}
+
+std::size_t ReplicationServer::Update(entt::registry& registry)
+{
+	ReceiveAcks();
+	if (!m_hasClient)
+		return 0;
+
+	m_sequence++;
+
+	// Capture du snapshot courant, trié par identifiant d'entité
+	HistoryEntry& entry = m_history[m_sequence % HistorySize];
+	entry.sequence = m_sequence;
+	entry.valid = true;
+	entry.snapshot.clear();
+
+	auto view = registry.view<Position, Velocity>();
+	for (entt::entity entity : view)
+	{
+		const auto& pos = view.get<Position>(entity);
+		const auto& vel = view.get<Velocity>(entity);
+
+		ReplicatedState& state = entry.snapshot.emplace_back();
+		state.id = entt::to_integral(entity);
+		state.values[0] = Quantize(pos.x, PositionPrecision);
+		state.values[1] = Quantize(pos.y, PositionPrecision);
+		state.values[2] = Quantize(vel.x, VelocityPrecision);
+		state.values[3] = Quantize(vel.y, VelocityPrecision);
+	}
+
+	std::sort(entry.snapshot.begin(), entry.snapshot.end(), [](const ReplicatedState& lhs, const ReplicatedState& rhs) { return lhs.id < rhs.id; });
+
+	// La référence est le dernier snapshot acquitté, s'il est encore dans l'historique
+	static const ReplicationSnapshot EmptySnapshot;
+
+	const HistoryEntry* baseline = nullptr;
+	if (m_hasAck && static_cast<std::uint16_t>(m_sequence - m_ackSequence) < HistorySize)
+	{
+		const HistoryEntry& ackedEntry = m_history[m_ackSequence % HistorySize];
+		if (ackedEntry.valid && ackedEntry.sequence == m_ackSequence)
+			baseline = &ackedEntry;
+	}
+
+	m_writer.Clear();
+	EncodeDelta(m_writer, baseline ? baseline->snapshot : EmptySnapshot, entry.snapshot);
+
+	const std::vector<std::uint8_t>& payload = m_writer.GetData();
+	std::size_t fragmentCount = std::max<std::size_t>((payload.size() + FragmentPayloadSize - 1) / FragmentPayloadSize, 1);
+	if (fragmentCount > UINT16_MAX)
+		throw std::runtime_error("replication snapshot is too large");
+
+	std::size_t sentBytes = 0;
+	for (std::size_t fragmentIndex = 0; fragmentIndex < fragmentCount; ++fragmentIndex)
+	{
+		std::size_t offset = fragmentIndex * FragmentPayloadSize;
+		std::size_t size = std::min(FragmentPayloadSize, payload.size() - offset);
+
+		m_datagram.resize(SnapshotHeaderSize + size);
+		m_datagram[0] = static_cast<std::uint8_t>(PacketType::Snapshot);
+		WriteU16(&m_datagram[1], m_sequence);
+		WriteU16(&m_datagram[3], baseline ? baseline->sequence : 0);
+		m_datagram[5] = baseline ? 1 : 0;
+		WriteU16(&m_datagram[6], static_cast<std::uint16_t>(fragmentIndex));
+		WriteU16(&m_datagram[8], static_cast<std::uint16_t>(fragmentCount));
+		std::copy_n(payload.data() + offset, size, m_datagram.data() + SnapshotHeaderSize);
+
+		m_socket.Send(m_clientAddress, m_datagram.data(), m_datagram.size());
+		sentBytes += m_datagram.size();
+	}
+
+	return sentBytes;
+}
+
+void ReplicationServer::ReceiveAcks()
+{
+	UdpAddress sender;
+	while (m_socket.Receive(m_receiveBuffer, sender))
+	{
+		if (m_receiveBuffer.size() < 4 || m_receiveBuffer[0] != static_cast<std::uint8_t>(PacketType::Ack))
+			continue;
+
+		// Le premier client à s'annoncer est le seul écouté ensuite : n'importe quel autre expéditeur pourrait sinon
+		// détourner le flux de snapshots ou fausser la référence des deltas
+		if (!m_hasClient)
+		{
+			m_clientAddress = sender;
+			m_hasClient = true;
+			m_hasAck = false;
+		}
+		else if (sender != m_clientAddress)
+			continue;
+
+		if (m_receiveBuffer[1] == 0)
+			continue; //< Simple annonce, le client n'a encore rien reçu
+
+		std::uint16_t sequence = ReadU16(&m_receiveBuffer[2]);
+		if (!m_hasAck || IsSequenceNewer(sequence, m_ackSequence))
+		{
+			m_ackSequence = sequence;
+			m_hasAck = true;
+		}
+	}
+}
+
+ReplicationClient::ReplicationClient(UdpSocket& socket, const UdpAddress& serverAddress, SpawnCallback spawnCallback) :
+m_spawnCallback(std::move(spawnCallback)),
+m_serverAddress(serverAddress),
+m_socket(socket),
+m_receivedFragmentCount(0),
+m_pendingBaseline(0),
+m_pendingSequence(0),
+m_sequence(0),
+m_hasPending(false),
+m_hasSnapshot(false),
+m_pendingHasBaseline(false)
+{
+}
+
+entt::entity ReplicationClient::FindEntity(std::uint32_t id) const
+{
+	auto it = m_entities.find(id);
+	if (it == m_entities.end())
+		return entt::null;
+
+	return it->second;
+}
+
+std::uint16_t ReplicationClient::GetSequence() const
+{
+	return m_sequence;
+}
+
+bool ReplicationClient::HasSnapshot() const
+{
+	return m_hasSnapshot;
+}
+
+bool ReplicationClient::Update(entt::registry& registry)
+{
+	const HistoryEntry* latestEntry = nullptr;
+
+	UdpAddress sender;
+	while (m_socket.Receive(m_receiveBuffer, sender))
+	{
+		if (sender != m_serverAddress || !ReceiveFragment(m_receiveBuffer))
+			continue;
+
+		// Snapshot complet : on le reconstruit à partir de sa référence
+		static const ReplicationSnapshot EmptySnapshot;
+
+		const ReplicationSnapshot* baseline = &EmptySnapshot;
+		if (m_pendingHasBaseline)
+		{
+			const HistoryEntry& baselineEntry = m_history[m_pendingBaseline % ReplicationServer::HistorySize];
+			if (!baselineEntry.valid || baselineEntry.sequence != m_pendingBaseline)
+				continue; //< Référence trop ancienne, le serveur finira par en utiliser une plus récente
+
+			baseline = &baselineEntry.snapshot;
+		}
+
+		m_payload.clear();
+		for (const std::vector<std::uint8_t>& fragment : m_fragments)
+			m_payload.insert(m_payload.end(), fragment.begin(), fragment.end());
+
+		HistoryEntry& entry = m_history[m_pendingSequence % ReplicationServer::HistorySize];
+		entry.valid = false;
+
+		// Un datagramme tronqué ou corrompu ne doit pas interrompre le client : le snapshot est abandonné (son entrée reste invalide)
+		// et le dernier snapshot correct continue d'être acquitté, le serveur enverra donc un delta à partir de celui-ci
+		try
+		{
+			BitReader reader(m_payload.data(), m_payload.size());
+			DecodeDelta(reader, *baseline, entry.snapshot);
+		}
+		catch (const std::exception&)
+		{
+			continue;
+		}
+
+		entry.sequence = m_pendingSequence;
+		entry.valid = true;
+
+		m_sequence = m_pendingSequence;
+		m_hasSnapshot = true;
+		latestEntry = &entry;
+	}
+
+	// Tant que rien n'a été reçu, le client s'annonce au serveur ; ensuite il acquitte le dernier snapshot reconstruit
+	SendAck();
+
+	if (!latestEntry)
+		return false;
+
+	ApplySnapshot(registry, latestEntry->snapshot);
+	return true;
+}
+
+void ReplicationClient::ApplySnapshot(entt::registry& registry, const ReplicationSnapshot& snapshot)
+{
+	// Les entités absentes du nouveau snapshot ont disparu côté serveur
+	std::size_t snapshotIndex = 0;
+	for (const ReplicatedState& appliedState : m_appliedSnapshot)
+	{
+		while (snapshotIndex < snapshot.size() && snapshot[snapshotIndex].id < appliedState.id)
+			snapshotIndex++;
+
+		if (snapshotIndex < snapshot.size() && snapshot[snapshotIndex].id == appliedState.id)
+			continue;
+
+		auto it = m_entities.find(appliedState.id);
+		if (it != m_entities.end())
+		{
+			if (registry.valid(it->second))
+				registry.destroy(it->second);
+
+			m_entities.erase(it);
+		}
+	}
+
+	for (const ReplicatedState& state : snapshot)
+	{
+		entt::entity entity;
+
+		auto it = m_entities.find(state.id);
+		if (it == m_entities.end() || !registry.valid(it->second))
+		{
+			entity = registry.create();
+			registry.emplace<Position>(entity);
+			registry.emplace<Velocity>(entity);
+
+			m_entities[state.id] = entity;
+
+			if (m_spawnCallback)
+				m_spawnCallback(registry, entity);
+		}
+		else
+			entity = it->second;
+
+		auto& pos = registry.get<Position>(entity);
+		pos.x = state.values[0] / PositionPrecision;
+		pos.y = state.values[1] / PositionPrecision;
+
+		auto& vel = registry.get<Velocity>(entity);
+		vel.x = state.values[2] / VelocityPrecision;
+		vel.y = state.values[3] / VelocityPrecision;
+	}
+
+	m_appliedSnapshot = snapshot;
+}
+
+bool ReplicationClient::ReceiveFragment(const std::vector<std::uint8_t>& datagram)
+{
+	if (datagram.size() < SnapshotHeaderSize || datagram[0] != static_cast<std::uint8_t>(PacketType::Snapshot))
+		return false;
+
+	std::uint16_t sequence = ReadU16(&datagram[1]);
+	std::uint16_t baseline = ReadU16(&datagram[3]);
+	bool hasBaseline = datagram[5] != 0;
+	std::uint16_t fragmentIndex = ReadU16(&datagram[6]);
+	std::uint16_t fragmentCount = ReadU16(&datagram[8]);
+
+	if (fragmentCount == 0 || fragmentIndex >= fragmentCount)
+		return false;
+
+	// Un snapshot plus ancien que le dernier reconstruit n'a plus d'intérêt
+	if (m_hasSnapshot && !IsSequenceNewer(sequence, m_sequence))
+		return false;
+
+	// Un nouveau snapshot remplace celui en cours de réassemblage (dont un fragment a pu être perdu)
+	if (!m_hasPending || sequence != m_pendingSequence)
+	{
+		if (m_hasPending && !IsSequenceNewer(sequence, m_pendingSequence))
+			return false;
+
+		m_pendingSequence = sequence;
+		m_pendingBaseline = baseline;
+		m_pendingHasBaseline = hasBaseline;
+		m_hasPending = true;
+		m_receivedFragmentCount = 0;
+
+		m_fragments.resize(fragmentCount);
+		for (std::vector<std::uint8_t>& fragment : m_fragments)
+			fragment.clear();
+	}
+
+	if (fragmentCount != m_fragments.size())
+		return false;
+
+	std::vector<std::uint8_t>& fragment = m_fragments[fragmentIndex];
+	if (!fragment.empty())
+		return false; //< Doublon
+
+	fragment.assign(datagram.begin() + SnapshotHeaderSize, datagram.end());
+	if (fragment.empty())
+		fragment.push_back(0); //< Un snapshot vide tient dans un fragment d'un octet (les compteurs à zéro)
+
+	if (++m_receivedFragmentCount < m_fragments.size())
+		return false;
+
+	m_hasPending = false;
+	return true;
+}
+
+void ReplicationClient::SendAck()
+{
+	std::uint8_t ack[4];
+	ack[0] = static_cast<std::uint8_t>(PacketType::Ack);
+	ack[1] = m_hasSnapshot ? 1 : 0;
+	WriteU16(&ack[2], m_sequence);
+
+	m_socket.Send(m_serverAddress, ack, sizeof(ack));
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "BitStream.hpp"
+#include "UdpSocket.hpp"
+#include <entt/entt.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Réplication des Position/Velocity d'un registre serveur vers un registre client, via UDP
+//
+// À chaque tick, le serveur capture un snapshot quantifié (1/16 de pixel pour les positions, 1/8 pour les vitesses)
+// et n'envoie que sa différence avec le dernier snapshot acquitté par le client : entités apparues ou disparues,
+// et pour les autres uniquement les champs ayant changé, sous forme d'écarts codés sur le moins de bits possible.
+// Sans acquittement (début de partie, paquets perdus trop longtemps), le snapshot est envoyé en entier.
+// Un snapshot trop gros pour un datagramme est découpé en fragments ; il n'est appliqué qu'une fois tous reçus.
+// Le serveur ne sert que le premier client à s'être annoncé, et un datagramme que le client ne peut pas décoder est simplement ignoré.
+
+struct ReplicatedState
+{
+	std::uint32_t id;
+	std::int32_t values[4]; //< Position x/y puis Velocity x/y, quantifiées
+};
+
+using ReplicationSnapshot = std::vector<ReplicatedState>;
+
+class ReplicationServer
+{
+public:
+	ReplicationServer(UdpSocket& socket);
+	ReplicationServer(const ReplicationServer&) = delete;
+	ReplicationServer(ReplicationServer&&) = delete;
+	~ReplicationServer() = default;
+
+	std::uint16_t GetSequence() const;
+	bool HasClient() const;
+
+	std::size_t Update(entt::registry& registry);
+
+	ReplicationServer& operator=(const ReplicationServer&) = delete;
+	ReplicationServer& operator=(ReplicationServer&&) = delete;
+
+	static constexpr std::size_t HistorySize = 32;
+
+private:
+	struct HistoryEntry
+	{
+		ReplicationSnapshot snapshot;
+		std::uint16_t sequence = 0;
+		bool valid = false;
+	};
+
+	void ReceiveAcks();
+
+	std::array<HistoryEntry, HistorySize> m_history;
+	std::vector<std::uint8_t> m_datagram;
+	std::vector<std::uint8_t> m_receiveBuffer;
+	BitWriter m_writer;
+	UdpAddress m_clientAddress;
+	UdpSocket& m_socket;
+	std::uint16_t m_ackSequence;
+	std::uint16_t m_sequence;
+	bool m_hasAck;
+	bool m_hasClient;
+};
+
+class ReplicationClient
+{
+public:
+	// Appelé pour chaque entité répliquée nouvellement créée, pour lui ajouter de quoi l'afficher par exemple
+	using SpawnCallback = std::function<void(entt::registry& registry, entt::entity entity)>;
+
+	ReplicationClient(UdpSocket& socket, const UdpAddress& serverAddress, SpawnCallback spawnCallback = nullptr);
+	ReplicationClient(const ReplicationClient&) = delete;
+	ReplicationClient(ReplicationClient&&) = delete;
+	~ReplicationClient() = default;
+
+	// Entité locale représentant l'entité serveur d'identifiant donné, entt::null si elle n'est pas (encore) répliquée
+	entt::entity FindEntity(std::uint32_t id) const;
+
+	std::uint16_t GetSequence() const;
+	bool HasSnapshot() const;
+
+	bool Update(entt::registry& registry);
+
+	ReplicationClient& operator=(const ReplicationClient&) = delete;
+	ReplicationClient& operator=(ReplicationClient&&) = delete;
+
+private:
+	struct HistoryEntry
+	{
+		ReplicationSnapshot snapshot;
+		std::uint16_t sequence = 0;
+		bool valid = false;
+	};
+
+	void ApplySnapshot(entt::registry& registry, const ReplicationSnapshot& snapshot);
+	bool ReceiveFragment(const std::vector<std::uint8_t>& datagram);
+	void SendAck();
+
+	std::array<HistoryEntry, ReplicationServer::HistorySize> m_history;
+	std::unordered_map<std::uint32_t, entt::entity> m_entities;
+	std::vector<std::vector<std::uint8_t>> m_fragments;
+	std::vector<std::uint8_t> m_payload;
+	std::vector<std::uint8_t> m_receiveBuffer;
+	ReplicationSnapshot m_appliedSnapshot;
+	SpawnCallback m_spawnCallback;
+	UdpAddress m_serverAddress;
+	UdpSocket& m_socket;
+	std::size_t m_receivedFragmentCount;
+	std::uint16_t m_pendingBaseline;
+	std::uint16_t m_pendingSequence;
+	std::uint16_t m_sequence;
+	bool m_hasPending;
+	bool m_hasSnapshot;
+	bool m_pendingHasBaseline;
+};
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "SharedComponentMirror.hpp"
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	constexpr std::uint32_t MirrorMagic = 0x45435353; //< "ECSS"
+	constexpr std::uint32_t MirrorVersion = 1;
+
+	// Disposition du segment : l'en-tête, puis pour chaque pool ses identifiants d'entités et ses composants
+	struct MirrorPoolHeader
+	{
+		char name[SharedComponentMirror::MaxPoolNameLength + 1];
+		std::uint32_t elementSize;
+		std::uint32_t count;
+		std::uint64_t entityOffset;
+		std::uint64_t componentOffset;
+	};
+
+	struct MirrorHeader
+	{
+		std::atomic<std::uint32_t> magic; //< Écrit en dernier, une fois la disposition du segment en place
+		std::atomic<std::uint32_t> sequence; //< Impair pendant l'écriture d'une frame
+		std::uint32_t version;
+		std::uint32_t poolCount;
+		std::uint64_t capacity;
+		std::uint64_t frame;
+		MirrorPoolHeader pools[SharedComponentMirror::MaxPoolCount];
+	};
+
+	// Le segment est partagé entre processus : les atomiques doivent être implémentées sans verrou
+	static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+	std::size_t AlignUp(std::size_t value, std::size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+#ifndef _WIN32
+	// Les noms POSIX de mémoire partagée commencent par un '/'
+	std::string GetSharedMemoryName(const std::string& name)
+	{
+		return "/" + name;
+	}
+#endif
+}
+
+SharedComponentMirror::SharedComponentMirror(std::string name, std::size_t capacity) :
+m_name(std::move(name)),
+m_segment(nullptr),
+m_capacity(capacity),
+m_segmentSize(0),
+m_frame(0)
+#ifdef _WIN32
+, m_fileMapping(nullptr)
+#endif
+{
+}
+
+SharedComponentMirror::~SharedComponentMirror()
+{
+	if (!m_segment)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_segment);
+	CloseHandle(m_fileMapping);
+#else
+	munmap(m_segment, m_segmentSize);
+	shm_unlink(GetSharedMemoryName(m_name).c_str());
+#endif
+}
+
+void SharedComponentMirror::Publish(entt::registry& registry)
+{
+	if (!m_segment)
+		Open();
+
+	MirrorHeader* header = reinterpret_cast<MirrorHeader*>(m_segment);
+
+	// Début d'écriture : le compteur devient impair, les lecteurs savent qu'ils doivent réessayer
+	std::uint32_t sequence = header->sequence.load(std::memory_order_relaxed);
+	header->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for (std::size_t i = 0; i < m_pools.size(); ++i)
+	{
+		MirrorPoolHeader& poolHeader = header->pools[i];
+
+		entt::entity* entities = reinterpret_cast<entt::entity*>(m_segment + poolHeader.entityOffset);
+		std::byte* components = m_segment + poolHeader.componentOffset;
+		poolHeader.count = static_cast<std::uint32_t>(m_pools[i].write(registry, entities, components, m_capacity));
+	}
+
+	header->frame = m_frame++;
+
+	// Fin d'écriture : le compteur redevient pair, la frame est cohérente
+	header->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void SharedComponentMirror::Open()
+{
+	std::size_t segmentSize = AlignUp(sizeof(MirrorHeader), 64);
+	for (const Pool& pool : m_pools)
+	{
+		segmentSize += AlignUp(m_capacity * sizeof(entt::entity), 64);
+		segmentSize += AlignUp(m_capacity * pool.elementSize, 64);
+	}
+
+#ifdef _WIN32
+	m_fileMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(segmentSize >> 32), static_cast<DWORD>(segmentSize), m_name.c_str());
+	if (!m_fileMapping)
+		throw std::runtime_error("failed to create shared memory " + m_name);
+
+	void* segment = MapViewOfFile(m_fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, segmentSize);
+	if (!segment)
+	{
+		CloseHandle(m_fileMapping);
+		throw std::runtime_error("failed to map shared memory " + m_name);
+	}
+#else
+	std::string sharedMemoryName = GetSharedMemoryName(m_name);
+
+	int fd = shm_open(sharedMemoryName.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+	if (fd < 0)
+		throw std::runtime_error("failed to create shared memory " + m_name);
+
+	if (ftruncate(fd, static_cast<off_t>(segmentSize)) != 0)
+	{
+		close(fd);
+		shm_unlink(sharedMemoryName.c_str());
+		throw std::runtime_error("failed to resize shared memory " + m_name);
+	}
+
+	void* segment = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd); //< Le mapping reste valide après la fermeture du descripteur
+	if (segment == MAP_FAILED)
+	{
+		shm_unlink(sharedMemoryName.c_str());
+		throw std::runtime_error("failed to map shared memory " + m_name);
+	}
+#endif
+
+	m_segment = static_cast<std::byte*>(segment);
+	m_segmentSize = segmentSize;
+
+	MirrorHeader* header = new (m_segment) MirrorHeader;
+	header->sequence.store(0, std::memory_order_relaxed);
+	header->version = MirrorVersion;
+	header->poolCount = static_cast<std::uint32_t>(m_pools.size());
+	header->capacity = m_capacity;
+	header->frame = 0;
+
+	std::size_t offset = AlignUp(sizeof(MirrorHeader), 64);
+	for (std::size_t i = 0; i < m_pools.size(); ++i)
+	{
+		MirrorPoolHeader& poolHeader = header->pools[i];
+		std::memset(poolHeader.name, 0, sizeof(poolHeader.name));
+		std::memcpy(poolHeader.name, m_pools[i].name.data(), m_pools[i].name.size());
+		poolHeader.elementSize = static_cast<std::uint32_t>(m_pools[i].elementSize);
+		poolHeader.count = 0;
+
+		poolHeader.entityOffset = offset;
+		offset += AlignUp(m_capacity * sizeof(entt::entity), 64);
+
+		poolHeader.componentOffset = offset;
+		offset += AlignUp(m_capacity * m_pools[i].elementSize, 64);
+	}
+
+	header->magic.store(MirrorMagic, std::memory_order_release);
+}
+
+const SharedMirrorSnapshot::Pool* SharedMirrorSnapshot::FindPool(std::string_view name) const
+{
+	for (const Pool& pool : pools)
+	{
+		if (pool.name == name)
+			return &pool;
+	}
+
+	return nullptr;
+}
+
+SharedComponentMirrorReader::SharedComponentMirrorReader(const std::string& name)
+{
+#ifdef _WIN32
+	m_fileMapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+	if (!m_fileMapping)
+		throw std::runtime_error("failed to open shared memory " + name);
+
+	const void* segment = MapViewOfFile(m_fileMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!segment)
+	{
+		CloseHandle(m_fileMapping);
+		throw std::runtime_error("failed to map shared memory " + name);
+	}
+
+	MEMORY_BASIC_INFORMATION info;
+	VirtualQuery(segment, &info, sizeof(info));
+	m_segmentSize = info.RegionSize;
+#else
+	int fd = shm_open(GetSharedMemoryName(name).c_str(), O_RDONLY, 0);
+	if (fd < 0)
+		throw std::runtime_error("failed to open shared memory " + name);
+
+	struct stat fileInfo;
+	if (fstat(fd, &fileInfo) != 0 || static_cast<std::size_t>(fileInfo.st_size) < sizeof(MirrorHeader))
+	{
+		close(fd);
+		throw std::runtime_error("shared memory " + name + " is not ready");
+	}
+
+	m_segmentSize = static_cast<std::size_t>(fileInfo.st_size);
+
+	void* segment = mmap(nullptr, m_segmentSize, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (segment == MAP_FAILED)
+		throw std::runtime_error("failed to map shared memory " + name);
+#endif
+
+	m_segment = static_cast<const std::byte*>(segment);
+}
+
+SharedComponentMirrorReader::~SharedComponentMirrorReader()
+{
+#ifdef _WIN32
+	UnmapViewOfFile(m_segment);
+	CloseHandle(m_fileMapping);
+#else
+	munmap(const_cast<std::byte*>(m_segment), m_segmentSize);
+#endif
+}
+
+bool SharedComponentMirrorReader::ReadSnapshot(SharedMirrorSnapshot& snapshot, unsigned int maxAttempts) const
+{
+	const MirrorHeader* header = reinterpret_cast<const MirrorHeader*>(m_segment);
+	if (header->magic.load(std::memory_order_acquire) != MirrorMagic || header->version != MirrorVersion)
+		return false;
+
+	for (unsigned int attempt = 0; attempt < maxAttempts; ++attempt)
+	{
+		std::uint32_t sequence = header->sequence.load(std::memory_order_acquire);
+		if (sequence & 1)
+		{
+			// Une frame est en cours d'écriture
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::size_t poolCount = std::min<std::size_t>(header->poolCount, SharedComponentMirror::MaxPoolCount);
+		std::size_t capacity = header->capacity;
+
+		snapshot.frame = header->frame;
+		snapshot.pools.resize(poolCount);
+		for (std::size_t i = 0; i < poolCount; ++i)
+		{
+			const MirrorPoolHeader& poolHeader = header->pools[i];
+			SharedMirrorSnapshot::Pool& pool = snapshot.pools[i];
+
+			// Les valeurs lues peuvent être incohérentes si l'écrivain est passé entre-temps : on les borne
+			// pour ne jamais lire hors du segment, la frame sera de toute façon rejetée
+			std::size_t count = std::min<std::size_t>(poolHeader.count, capacity);
+			if (poolHeader.componentOffset + count * poolHeader.elementSize > m_segmentSize)
+				count = 0;
+
+			pool.name.assign(poolHeader.name, std::find(poolHeader.name, poolHeader.name + sizeof(poolHeader.name), '\0'));
+			pool.elementSize = poolHeader.elementSize;
+			pool.entities.resize(count);
+			pool.components.resize(count * pool.elementSize);
+
+			std::memcpy(pool.entities.data(), m_segment + poolHeader.entityOffset, count * sizeof(entt::entity));
+			std::memcpy(pool.components.data(), m_segment + poolHeader.componentOffset, count * pool.elementSize);
+		}
+
+		// Si le compteur n'a pas bougé pendant la copie, aucune écriture n'a eu lieu : la copie est cohérente
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (header->sequence.load(std::memory_order_relaxed) == sequence)
+			return true;
+	}
+
+	return false;
+}
\ No newline at end of file
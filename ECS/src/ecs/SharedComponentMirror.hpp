@@ -0,0 +1,148 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Copie, frame après frame, certains pools de composants (Position, Velocity...) dans un segment de mémoire partagée
+// que d'autres processus (inspecteur, outils d'analyse) peuvent lire sans socket ni sérialisation, et sans ralentir le jeu.
+//
+// Le segment commence par un en-tête protégé par un seqlock : le compteur de séquence est impair pendant l'écriture d'une frame.
+// Le lecteur copie les données puis vérifie que le compteur n'a pas bougé, sinon il recommence : il obtient toujours
+// une frame cohérente sans jamais bloquer l'écrivain.
+// Seuls des composants trivialement copiables peuvent être partagés, et chaque pool est limité à la capacité donnée à la création.
+class SharedComponentMirror
+{
+public:
+	SharedComponentMirror(std::string name, std::size_t capacity);
+	SharedComponentMirror(const SharedComponentMirror&) = delete;
+	SharedComponentMirror(SharedComponentMirror&&) = delete;
+	~SharedComponentMirror();
+
+	void Publish(entt::registry& registry);
+
+	template<typename Component> void Register(std::string_view poolName);
+
+	SharedComponentMirror& operator=(const SharedComponentMirror&) = delete;
+	SharedComponentMirror& operator=(SharedComponentMirror&&) = delete;
+
+	static constexpr std::size_t MaxPoolCount = 16;
+	static constexpr std::size_t MaxPoolNameLength = 31;
+
+private:
+	template<typename Component> static std::size_t WritePool(entt::registry& registry, entt::entity* entities, std::byte* components, std::size_t capacity);
+
+	void Open();
+
+	struct Pool
+	{
+		std::string name;
+		std::size_t elementSize;
+		std::size_t(*write)(entt::registry& registry, entt::entity* entities, std::byte* components, std::size_t capacity);
+	};
+
+	std::string m_name;
+	std::vector<Pool> m_pools;
+	std::byte* m_segment;
+	std::size_t m_capacity;
+	std::size_t m_segmentSize;
+	std::uint64_t m_frame;
+#ifdef _WIN32
+	void* m_fileMapping;
+#endif
+};
+
+// Copie cohérente d'une frame lue depuis un SharedComponentMirror
+struct SharedMirrorSnapshot
+{
+	struct Pool
+	{
+		std::string name;
+		std::size_t elementSize;
+		std::vector<entt::entity> entities;
+		std::vector<std::byte> components;
+
+		template<typename Component> const Component& Get(std::size_t index) const;
+	};
+
+	const Pool* FindPool(std::string_view name) const;
+
+	std::uint64_t frame = 0;
+	std::vector<Pool> pools;
+};
+
+// Côté lecteur (un autre processus) : s'attache au segment créé par un SharedComponentMirror du même nom
+class SharedComponentMirrorReader
+{
+public:
+	SharedComponentMirrorReader(const std::string& name);
+	SharedComponentMirrorReader(const SharedComponentMirrorReader&) = delete;
+	SharedComponentMirrorReader(SharedComponentMirrorReader&&) = delete;
+	~SharedComponentMirrorReader();
+
+	bool ReadSnapshot(SharedMirrorSnapshot& snapshot, unsigned int maxAttempts = 100) const;
+
+	SharedComponentMirrorReader& operator=(const SharedComponentMirrorReader&) = delete;
+	SharedComponentMirrorReader& operator=(SharedComponentMirrorReader&&) = delete;
+
+private:
+	const std::byte* m_segment;
+	std::size_t m_segmentSize;
+#ifdef _WIN32
+	void* m_fileMapping;
+#endif
+};
+
+template<typename Component>
+void SharedComponentMirror::Register(std::string_view poolName)
+{
+	static_assert(std::is_trivially_copyable_v<Component>, "shared components must be trivially copyable");
+	static_assert(!std::is_empty_v<Component>, "empty components have no data to share");
+
+	// La disposition du segment est figée à sa création
+	if (m_segment)
+		throw std::runtime_error("pools must be registered before the first publish");
+
+	if (m_pools.size() >= MaxPoolCount)
+		throw std::runtime_error("too many shared pools");
+
+	if (poolName.size() > MaxPoolNameLength)
+		throw std::runtime_error("shared pool name is too long");
+
+	Pool& pool = m_pools.emplace_back();
+	pool.name = poolName;
+	pool.elementSize = sizeof(Component);
+	pool.write = &WritePool<Component>;
+}
+
+template<typename Component>
+std::size_t SharedComponentMirror::WritePool(entt::registry& registry, entt::entity* entities, std::byte* components, std::size_t capacity)
+{
+	std::size_t count = 0;
+	for (auto [entity, component] : registry.storage<Component>().each())
+	{
+		if (count >= capacity)
+			break;
+
+		entities[count] = entity;
+		std::memcpy(components + count * sizeof(Component), &component, sizeof(Component));
+		count++;
+	}
+
+	return count;
+}
+
+template<typename Component>
+const Component& SharedMirrorSnapshot::Pool::Get(std::size_t index) const
+{
+	if (sizeof(Component) != elementSize)
+		throw std::runtime_error("component size does not match shared pool " + name);
+
+	return reinterpret_cast<const Component*>(components.data())[index];
+}
\ No newline at end of file
@@ -0,0 +1,365 @@
+#include "SpatialShard.hpp"
+#include "UpdateClock.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace
+{
+	enum MigrantFlags : std::uint8_t
+	{
+		MigrantNoGravity = 1 << 0
+	};
+
+	// Chaque message est précédé de sa taille, puis du nombre de migrants et de fantômes qu'il contient
+	constexpr std::size_t SizePrefixLength = sizeof(std::uint64_t);
+	constexpr std::size_t MigrantRecordSize = sizeof(Position) + sizeof(Velocity) + 3;
+	constexpr std::size_t GhostRecordSize = sizeof(Position) + sizeof(Velocity);
+
+	template<typename T>
+	void Append(std::vector<std::byte>& buffer, const T& value)
+	{
+		std::size_t offset = buffer.size();
+		buffer.resize(offset + sizeof(T));
+		std::memcpy(&buffer[offset], &value, sizeof(T));
+	}
+
+	template<typename T>
+	T Read(const std::vector<std::byte>& buffer, std::size_t& offset)
+	{
+		if (offset + sizeof(T) > buffer.size())
+			throw std::runtime_error("truncated shard message");
+
+		T value;
+		std::memcpy(&value, &buffer[offset], sizeof(T));
+		offset += sizeof(T);
+
+		return value;
+	}
+
+	std::uint8_t GetBucketPeriod(const entt::registry& registry, entt::entity entity)
+	{
+		if (registry.all_of<UpdateEveryFrame>(entity))
+			return UpdateEveryFrame::Period;
+		else if (registry.all_of<UpdateEvery2Frames>(entity))
+			return UpdateEvery2Frames::Period;
+		else if (registry.all_of<UpdateEvery8Frames>(entity))
+			return UpdateEvery8Frames::Period;
+		else
+			return 0;
+	}
+}
+
+struct SpatialShard::Neighbour
+{
+	int socket = -1;
+	std::uint32_t ghostCount = 0;
+	std::uint32_t migrantCount = 0;
+	std::vector<std::byte> ghosts;
+	std::vector<std::byte> migrants;
+
+	std::vector<std::byte> outgoing;
+	std::size_t sentSize = 0;
+
+	std::vector<std::byte> incoming;
+	std::size_t receivedSize = 0;
+	bool incomingSizeKnown = false;
+
+	bool IsReceived() const { return incomingSizeKnown && receivedSize == incoming.size(); }
+	bool IsSent() const { return sentSize == outgoing.size(); }
+};
+
+SpatialShard::SpatialShard(entt::registry& registry, float minX, float maxX, float ghostWidth, int leftSocket, int rightSocket) :
+m_registry(registry),
+m_ghostCount(0),
+m_migratedCount(0),
+m_ghostWidth(ghostWidth),
+m_maxX(maxX),
+m_minX(minX),
+m_leftSocket(leftSocket),
+m_rightSocket(rightSocket)
+{
+	if (maxX - minX <= ghostWidth)
+		throw std::runtime_error("shard must be wider than its ghost region");
+}
+
+SpatialShard::~SpatialShard()
+{
+	if (m_leftSocket >= 0)
+		close(m_leftSocket);
+
+	if (m_rightSocket >= 0)
+		close(m_rightSocket);
+}
+
+void SpatialShard::Exchange()
+{
+	// Les fantômes de l'échange précédent sont périmés
+	auto ghostView = m_registry.view<Ghost>();
+	m_entitiesToDestroy.assign(ghostView.begin(), ghostView.end());
+	m_registry.destroy(m_entitiesToDestroy.begin(), m_entitiesToDestroy.end());
+	m_entitiesToDestroy.clear();
+	m_ghostCount = 0;
+
+	Neighbour neighbours[2];
+	Neighbour& left = neighbours[0];
+	Neighbour& right = neighbours[1];
+	left.socket = m_leftSocket;
+	right.socket = m_rightSocket;
+
+	CollectOutgoing(left, right);
+
+	// Les deux voisins sont servis simultanément : chaque shard envoie et reçoit en même temps,
+	// sans ordre imposé entre eux (et donc sans risque d'interblocage quand les buffers des sockets sont pleins)
+	Neighbour* activeNeighbours[2];
+	std::size_t activeNeighbourCount = 0;
+	for (Neighbour& neighbour : neighbours)
+	{
+		if (neighbour.socket < 0)
+			continue;
+
+		std::uint64_t payloadSize = 2 * sizeof(std::uint32_t) + neighbour.migrants.size() + neighbour.ghosts.size();
+
+		neighbour.outgoing.reserve(SizePrefixLength + payloadSize);
+		Append(neighbour.outgoing, payloadSize);
+		Append(neighbour.outgoing, neighbour.migrantCount);
+		Append(neighbour.outgoing, neighbour.ghostCount);
+		neighbour.outgoing.insert(neighbour.outgoing.end(), neighbour.migrants.begin(), neighbour.migrants.end());
+		neighbour.outgoing.insert(neighbour.outgoing.end(), neighbour.ghosts.begin(), neighbour.ghosts.end());
+
+		// On commence par recevoir la taille du message
+		neighbour.incoming.resize(SizePrefixLength);
+
+		activeNeighbours[activeNeighbourCount++] = &neighbour;
+	}
+
+	ExchangeMessages(neighbours, 2);
+
+	for (std::size_t i = 0; i < activeNeighbourCount; ++i)
+		ApplyIncoming(activeNeighbours[i]->incoming);
+}
+
+std::size_t SpatialShard::GetGhostCount() const
+{
+	return m_ghostCount;
+}
+
+float SpatialShard::GetMaxX() const
+{
+	return m_maxX;
+}
+
+float SpatialShard::GetMinX() const
+{
+	return m_minX;
+}
+
+std::size_t SpatialShard::GetMigratedCount() const
+{
+	return m_migratedCount;
+}
+
+void SpatialShard::CollectOutgoing(Neighbour& left, Neighbour& right)
+{
+	auto AppendGhost = [](Neighbour& neighbour, const Position& pos, const Velocity& vel)
+	{
+		Append(neighbour.ghosts, pos);
+		Append(neighbour.ghosts, vel);
+		neighbour.ghostCount++;
+	};
+
+	auto AppendMigrant = [&](Neighbour& neighbour, entt::entity entity, const Position& pos, const Velocity& vel)
+	{
+		Append(neighbour.migrants, pos);
+		Append(neighbour.migrants, vel);
+		Append(neighbour.migrants, static_cast<std::uint8_t>(m_registry.all_of<NoGravity>(entity) ? MigrantNoGravity : 0));
+		Append(neighbour.migrants, GetBucketPeriod(m_registry, entity));
+		Append(neighbour.migrants, static_cast<std::uint8_t>(GetUpdatePhase(m_registry, entity)));
+		neighbour.migrantCount++;
+	};
+
+	auto view = m_registry.view<Position, Velocity>(entt::exclude<Ghost>);
+	for (entt::entity entity : view)
+	{
+		const Position& pos = view.get<Position>(entity);
+		const Velocity& vel = view.get<Velocity>(entity);
+
+		if (pos.x < m_minX && left.socket >= 0)
+		{
+			AppendMigrant(left, entity, pos, vel);
+
+			// Le voisin a construit ses fantômes avant de recevoir ce migrant : s'il reste proche de la frontière,
+			// c'est à nous d'en garder une copie fantôme
+			if (pos.x >= m_minX - m_ghostWidth)
+				m_entitiesToGhost.push_back(entity);
+			else
+				m_entitiesToDestroy.push_back(entity);
+		}
+		else if (pos.x >= m_maxX && right.socket >= 0)
+		{
+			AppendMigrant(right, entity, pos, vel);
+
+			if (pos.x < m_maxX + m_ghostWidth)
+				m_entitiesToGhost.push_back(entity);
+			else
+				m_entitiesToDestroy.push_back(entity);
+		}
+		else
+		{
+			if (pos.x < m_minX + m_ghostWidth && left.socket >= 0)
+				AppendGhost(left, pos, vel);
+
+			if (pos.x >= m_maxX - m_ghostWidth && right.socket >= 0)
+				AppendGhost(right, pos, vel);
+		}
+	}
+
+	m_registry.destroy(m_entitiesToDestroy.begin(), m_entitiesToDestroy.end());
+	m_entitiesToDestroy.clear();
+
+	for (entt::entity entity : m_entitiesToGhost)
+	{
+		m_registry.remove<NoGravity>(entity);
+		RemoveUpdateBucket(m_registry, entity);
+		m_registry.emplace<Ghost>(entity);
+	}
+
+	m_ghostCount += m_entitiesToGhost.size();
+	m_entitiesToGhost.clear();
+	m_migratedCount += left.migrantCount + right.migrantCount;
+}
+
+void SpatialShard::ApplyIncoming(const std::vector<std::byte>& message)
+{
+	std::size_t offset = SizePrefixLength;
+	std::uint32_t migrantCount = Read<std::uint32_t>(message, offset);
+	std::uint32_t ghostCount = Read<std::uint32_t>(message, offset);
+
+	if (message.size() - offset != migrantCount * MigrantRecordSize + ghostCount * GhostRecordSize)
+		throw std::runtime_error("malformed shard message");
+
+	for (std::uint32_t i = 0; i < migrantCount; ++i)
+	{
+		Position pos = Read<Position>(message, offset);
+		Velocity vel = Read<Velocity>(message, offset);
+		std::uint8_t flags = Read<std::uint8_t>(message, offset);
+		std::uint8_t bucketPeriod = Read<std::uint8_t>(message, offset);
+		std::uint8_t bucketPhase = Read<std::uint8_t>(message, offset);
+
+		entt::entity entity = m_registry.create();
+		m_registry.emplace<Position>(entity, pos);
+		m_registry.emplace<Velocity>(entity, vel);
+
+		if (flags & MigrantNoGravity)
+			m_registry.emplace<NoGravity>(entity);
+
+		// Les shards avancent au même rythme : la phase reçue garde la migrante synchronisée avec ses mises à jour passées
+		if (bucketPeriod != 0)
+			SetUpdateBucket(m_registry, entity, bucketPeriod, bucketPhase);
+	}
+
+	for (std::uint32_t i = 0; i < ghostCount; ++i)
+	{
+		Position pos = Read<Position>(message, offset);
+		Velocity vel = Read<Velocity>(message, offset);
+
+		entt::entity entity = m_registry.create();
+		m_registry.emplace<Position>(entity, pos);
+		m_registry.emplace<Velocity>(entity, vel);
+		m_registry.emplace<Ghost>(entity);
+	}
+
+	m_ghostCount += ghostCount;
+}
+
+void SpatialShard::ExchangeMessages(Neighbour* neighbours, std::size_t neighbourCount)
+{
+	for (;;)
+	{
+		pollfd fds[2];
+		Neighbour* polledNeighbours[2];
+		nfds_t fdCount = 0;
+
+		for (std::size_t i = 0; i < neighbourCount; ++i)
+		{
+			Neighbour& neighbour = neighbours[i];
+			if (neighbour.socket < 0)
+				continue;
+
+			short events = 0;
+			if (!neighbour.IsSent())
+				events |= POLLOUT;
+
+			if (!neighbour.IsReceived())
+				events |= POLLIN;
+
+			if (events == 0)
+				continue;
+
+			fds[fdCount].fd = neighbour.socket;
+			fds[fdCount].events = events;
+			fds[fdCount].revents = 0;
+			polledNeighbours[fdCount] = &neighbour;
+			fdCount++;
+		}
+
+		if (fdCount == 0)
+			break;
+
+		if (poll(fds, fdCount, -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			throw std::runtime_error("failed to poll shard sockets");
+		}
+
+		for (nfds_t i = 0; i < fdCount; ++i)
+		{
+			Neighbour& neighbour = *polledNeighbours[i];
+
+			if (fds[i].revents & POLLOUT)
+			{
+				ssize_t sent = send(neighbour.socket, neighbour.outgoing.data() + neighbour.sentSize, neighbour.outgoing.size() - neighbour.sentSize, MSG_DONTWAIT | MSG_NOSIGNAL);
+				if (sent > 0)
+					neighbour.sentSize += static_cast<std::size_t>(sent);
+				else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+					throw std::runtime_error("failed to send to shard neighbour");
+			}
+
+			if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+			{
+				ssize_t received = recv(neighbour.socket, neighbour.incoming.data() + neighbour.receivedSize, neighbour.incoming.size() - neighbour.receivedSize, MSG_DONTWAIT);
+				if (received == 0)
+					throw std::runtime_error("shard neighbour disconnected");
+				else if (received < 0)
+				{
+					if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+						throw std::runtime_error("failed to receive from shard neighbour");
+
+					continue;
+				}
+
+				neighbour.receivedSize += static_cast<std::size_t>(received);
+
+				// Une fois la taille connue, le buffer est agrandi pour recevoir le reste du message
+				if (!neighbour.incomingSizeKnown && neighbour.receivedSize == SizePrefixLength)
+				{
+					std::uint64_t payloadSize;
+					std::memcpy(&payloadSize, neighbour.incoming.data(), sizeof(payloadSize));
+
+					neighbour.incoming.resize(SizePrefixLength + payloadSize);
+					neighbour.incomingSizeKnown = true;
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Components.hpp"
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <vector>
+
+// Tranche verticale [minX, maxX[ d'un monde découpé entre plusieurs processus, chacun simulant son propre registre
+//
+// À chaque tick, Exchange échange avec les shards voisins (via des sockets UNIX connectées) :
+// - les entités qui ont franchi une frontière migrent vers le shard voisin, qui en devient propriétaire ;
+// - les entités situées à moins de ghostWidth d'une frontière sont envoyées en copie (tag Ghost) au voisin,
+//   pour que les requêtes de voisinage (contacts, interactions) voient au-delà de la frontière.
+// Les fantômes sont recréés à chaque échange et ne sont jamais simulés localement.
+//
+// Une entité ne doit pas traverser plus d'un shard par tick, et la largeur d'un shard doit dépasser ghostWidth.
+// Seuls Position, Velocity, NoGravity et le bucket de mise à jour sont transmis lors d'une migration.
+class SpatialShard
+{
+public:
+	SpatialShard(entt::registry& registry, float minX, float maxX, float ghostWidth, int leftSocket, int rightSocket);
+	SpatialShard(const SpatialShard&) = delete;
+	SpatialShard(SpatialShard&&) = delete;
+	~SpatialShard();
+
+	void Exchange();
+
+	std::size_t GetGhostCount() const;
+	float GetMaxX() const;
+	float GetMinX() const;
+	std::size_t GetMigratedCount() const;
+
+	SpatialShard& operator=(const SpatialShard&) = delete;
+	SpatialShard& operator=(SpatialShard&&) = delete;
+
+private:
+	struct Neighbour;
+
+	void CollectOutgoing(Neighbour& left, Neighbour& right);
+	void ApplyIncoming(const std::vector<std::byte>& message);
+
+	static void ExchangeMessages(Neighbour* neighbours, std::size_t neighbourCount);
+
+	std::vector<entt::entity> m_entitiesToDestroy;
+	std::vector<entt::entity> m_entitiesToGhost;
+	entt::registry& m_registry;
+	std::size_t m_ghostCount;
+	std::size_t m_migratedCount;
+	float m_ghostWidth;
+	float m_maxX;
+	float m_minX;
+	int m_leftSocket;
+	int m_rightSocket;
+};
\ No newline at end of file
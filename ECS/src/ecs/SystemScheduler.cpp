@@ -0,0 +1,73 @@
+#include "SystemScheduler.hpp"
+#include <stdexcept>
+
+SystemScheduler::SystemScheduler(const SDLpp& sdl, float frameBudget, unsigned int maxDeferredFrames) :
+m_sdl(sdl),
+m_frameBudget(frameBudget),
+m_deferredCount(0),
+m_maxDeferredFrames(maxDeferredFrames)
+{
+}
+
+float SystemScheduler::GetEstimatedCost(const std::string& name) const
+{
+	for (const Entry& entry : m_systems)
+	{
+		if (entry.name == name)
+			return entry.estimatedCost;
+	}
+
+	throw std::runtime_error("unknown system " + name);
+}
+
+unsigned int SystemScheduler::GetDeferredCount() const
+{
+	return m_deferredCount;
+}
+
+void SystemScheduler::Register(std::string name, SystemPriority priority, float estimatedCost, System system)
+{
+	Entry& entry = m_systems.emplace_back();
+	entry.name = std::move(name);
+	entry.system = std::move(system);
+	entry.priority = priority;
+	entry.estimatedCost = estimatedCost;
+}
+
+void SystemScheduler::Run(Uint64 frameStart, float elapsedTime)
+{
+	m_deferredCount = 0;
+
+	// Les systèmes sont exécutés dans leur ordre d'enregistrement
+	for (Entry& entry : m_systems)
+	{
+		// Un système repoussé accumule le temps écoulé, pour rattraper son retard lorsqu'il sera exécuté
+		entry.pendingTime += elapsedTime;
+
+		if (entry.priority == SystemPriority::Low && entry.deferredFrames < m_maxDeferredFrames)
+		{
+			// On ne lance un système de faible priorité que si son coût estimé tient dans ce qu'il reste du budget de la frame,
+			// au-delà de maxDeferredFrames frames repoussées on l'exécute quoi qu'il arrive pour ne pas l'affamer
+			float remainingBudget = m_frameBudget - GetTimeSince(frameStart);
+			if (entry.estimatedCost > remainingBudget)
+			{
+				entry.deferredFrames++;
+				m_deferredCount++;
+				continue;
+			}
+		}
+
+		Uint64 systemStart = m_sdl.GetPerformanceCounter();
+		entry.system(entry.pendingTime);
+
+		// Le coût estimé suit le coût mesuré (moyenne mobile exponentielle), pour s'adapter à la charge réelle
+		entry.estimatedCost += (GetTimeSince(systemStart) - entry.estimatedCost) * 0.1f;
+		entry.pendingTime = 0.f;
+		entry.deferredFrames = 0;
+	}
+}
+
+float SystemScheduler::GetTimeSince(Uint64 counter) const
+{
+	return static_cast<float>(m_sdl.GetPerformanceCounter() - counter) / static_cast<float>(m_sdl.GetPerformanceFrequency());
+}
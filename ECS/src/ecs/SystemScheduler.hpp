@@ -0,0 +1,55 @@
+#pragma once
+
+#include "sdlcpp/SDLpp.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Priorité d'un système : les systèmes critiques s'exécutent à chaque frame,
+// les systèmes de faible priorité (IA, nettoyage, statistiques) peuvent être repoussés
+// à une frame plus légère si la frame courante risque de dépasser son budget
+enum class SystemPriority
+{
+	Critical,
+	Low
+};
+
+class SystemScheduler
+{
+public:
+	using System = std::function<void(float elapsedTime)>;
+
+	SystemScheduler(const SDLpp& sdl, float frameBudget, unsigned int maxDeferredFrames = 8);
+	SystemScheduler(const SystemScheduler&) = delete;
+	SystemScheduler(SystemScheduler&&) = delete;
+	~SystemScheduler() = default;
+
+	float GetEstimatedCost(const std::string& name) const;
+	unsigned int GetDeferredCount() const;
+
+	void Register(std::string name, SystemPriority priority, float estimatedCost, System system);
+
+	void Run(Uint64 frameStart, float elapsedTime);
+
+	SystemScheduler& operator=(const SystemScheduler&) = delete;
+	SystemScheduler& operator=(SystemScheduler&&) = delete;
+
+private:
+	struct Entry
+	{
+		std::string name;
+		System system;
+		SystemPriority priority;
+		float estimatedCost;
+		float pendingTime = 0.f;
+		unsigned int deferredFrames = 0;
+	};
+
+	float GetTimeSince(Uint64 counter) const;
+
+	std::vector<Entry> m_systems;
+	const SDLpp& m_sdl;
+	float m_frameBudget;
+	unsigned int m_deferredCount;
+	unsigned int m_maxDeferredFrames;
+};
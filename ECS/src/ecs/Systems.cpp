@@ -0,0 +1,152 @@
+#include "Systems.hpp"
+#include <cmath>
+#include <utility>
+#include <vector>
+
+void PlayerControllerSystem(entt::registry& registry)
+{
+	auto view = registry.view<Input, Velocity>();
+	view.each([](const Input& input, Velocity& velocity)
+	{
+		velocity.x = 0.f;
+		velocity.y = 0.f;
+
+		if (input.up)
+			velocity.y += -500.f;
+
+		if (input.down)
+			velocity.y += 500.f;
+
+		if (input.left)
+			velocity.x += -500.f;
+
+		if (input.right)
+			velocity.x += 500.f;
+	});
+}
+
+void InputSystem(const SDLpp& sdl, entt::registry& registry)
+{
+	const Uint8* state = sdl.GetKeyboardState();
+
+	auto view = registry.view<Input>();
+	for (entt::entity entity : view)
+	{
+		auto& input = view.get<Input>(entity);
+		input.down = state[SDL_SCANCODE_DOWN];
+		input.left = state[SDL_SCANCODE_LEFT];
+		input.right = state[SDL_SCANCODE_RIGHT];
+		input.up = state[SDL_SCANCODE_UP];
+	}
+}
+
+void FlowFieldSystem(entt::registry& registry, const FlowField& flowField)
+{
+	// Chaque agent lit sa direction dans le champ de flux (calculé une seule fois pour tous les agents)
+	auto view = registry.view<Position, Velocity, FlowFieldAgent>();
+	for (entt::entity entity : view)
+	{
+		auto& entityPos = view.get<Position>(entity);
+		auto& entityVel = view.get<Velocity>(entity);
+		auto& entityAgent = view.get<FlowFieldAgent>(entity);
+
+		float directionX;
+		float directionY;
+		if (flowField.Sample(entityPos.x, entityPos.y, directionX, directionY))
+		{
+			entityVel.x = directionX * entityAgent.speed;
+			entityVel.y = directionY * entityAgent.speed;
+		}
+		else
+		{
+			// Le joueur est inaccessible depuis cette position, l'agent s'arrête
+			entityVel.x = 0.f;
+			entityVel.y = 0.f;
+		}
+	}
+}
+
+void GravitySystem(entt::registry& registry, const UpdateClock& clock, float gravityConstant)
+{
+	// Nous ne voulons que les entités ayant une vélocité (et n'ayant pas de composant NoGravity)
+	// et dont le bucket doit être mis à jour cette frame
+	ForEachDue<Velocity>(registry, clock, entt::exclude<NoGravity>, [&](entt::entity /*entity*/, float elapsedTime, Velocity& entityVel)
+	{
+		entityVel.y += gravityConstant * elapsedTime;
+	});
+}
+
+void RenderSystem(entt::registry& registry, SDLppRenderer& renderer)
+{
+	auto view = registry.view<Position, Drawable>();
+	for (entt::entity entity : view)
+	{
+		auto& entityPos = view.get<Position>(entity);
+		auto& entityDrawable = view.get<Drawable>(entity);
+
+		SDL_Rect rect;
+		rect.x = static_cast<int>(entityPos.x);
+		rect.y = static_cast<int>(entityPos.y);
+		rect.w = entityDrawable.width;
+		rect.h = entityDrawable.height;
+
+		if (SDL_RectEmpty(&entityDrawable.sourceRect))
+			renderer.Copy(*entityDrawable.texture, rect);
+		else
+			renderer.Copy(*entityDrawable.texture, entityDrawable.sourceRect, rect);
+	}
+}
+
+void UpdateBucketSystem(entt::registry& registry, const UpdateClock& clock, entt::entity player, const SDL_Rect& viewport)
+{
+	// En dessous de NearDistance (ou à l'écran) une entité est mise à jour à chaque frame,
+	// en dessous de FarDistance une frame sur deux, et au-delà une frame sur huit
+	const float NearDistance = 1000.f;
+	const float FarDistance = 4000.f;
+
+	const auto& playerPos = registry.get<Position>(player);
+
+	// On ne réévalue le bucket d'une entité qu'au moment de sa mise à jour, sans quoi ce système
+	// parcourrait à nouveau toutes les entités à chaque frame.
+	// Les changements sont appliqués après l'itération, pour ne pas modifier les vues en cours de parcours.
+	// Ce système doit être exécuté après ceux qui utilisent les buckets : une entité changeant de bucket a alors déjà été
+	// mise à jour pendant cette frame, et son nouveau bucket la remet à jour exactement une période plus tard
+	std::vector<std::pair<entt::entity, unsigned int>> changes;
+
+	ForEachDue<Position>(registry, clock, entt::exclude<>, [&](entt::entity entity, float /*elapsedTime*/, const Position& entityPos)
+	{
+		unsigned int period;
+
+		bool onScreen = entityPos.x >= viewport.x && entityPos.x < viewport.x + viewport.w &&
+		                entityPos.y >= viewport.y && entityPos.y < viewport.y + viewport.h;
+
+		float distance = std::hypot(entityPos.x - playerPos.x, entityPos.y - playerPos.y);
+		if (onScreen || distance < NearDistance)
+			period = UpdateEveryFrame::Period;
+		else if (distance < FarDistance)
+			period = UpdateEvery2Frames::Period;
+		else
+			period = UpdateEvery8Frames::Period;
+
+		changes.emplace_back(entity, period);
+	});
+
+	for (auto&& [entity, period] : changes)
+	{
+		bool inBucket = (period == UpdateEveryFrame::Period && registry.all_of<UpdateEveryFrame>(entity)) ||
+		                (period == UpdateEvery2Frames::Period && registry.all_of<UpdateEvery2Frames>(entity)) ||
+		                (period == UpdateEvery8Frames::Period && registry.all_of<UpdateEvery8Frames>(entity));
+
+		if (!inBucket)
+			SetUpdateBucket(registry, entity, period, clock.GetCurrentPhase(period));
+	}
+}
+
+void VelocitySystem(entt::registry& registry, const UpdateClock& clock)
+{
+	ForEachDue<Position, Velocity>(registry, clock, entt::exclude<>, [&](entt::entity /*entity*/, float elapsedTime, Position& entityPos, const Velocity& entityVel)
+	{
+		entityPos.x += entityVel.x * elapsedTime;
+		entityPos.y += entityVel.y * elapsedTime;
+	});
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Components.hpp"
+#include "FlowField.hpp"
+#include "UpdateClock.hpp"
+#include "sdlcpp/SDLpp.hpp"
+#include "sdlcpp/SDLppRenderer.hpp"
+#include <entt/entt.hpp>
+
+void PlayerControllerSystem(entt::registry& registry);
+void InputSystem(const SDLpp& sdl, entt::registry& registry);
+void FlowFieldSystem(entt::registry& registry, const FlowField& flowField);
+void GravitySystem(entt::registry& registry, const UpdateClock& clock, float gravityConstant = 981.f);
+void RenderSystem(entt::registry& registry, SDLppRenderer& renderer);
+void UpdateBucketSystem(entt::registry& registry, const UpdateClock& clock, entt::entity player, const SDL_Rect& viewport);
+void VelocitySystem(entt::registry& registry, const UpdateClock& clock);
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int threadCount) :
+m_nextIndex(0),
+m_count(0),
+m_generation(0),
+m_grainSize(1),
+m_job(nullptr),
+m_activeWorkers(0),
+m_stop(false)
+{
+	// Le thread appelant ParallelFor travaille lui aussi, il nous faut donc un worker de moins que de threads
+	unsigned int workerCount = std::max(threadCount, 1u) - 1;
+	for (unsigned int i = 0; i < workerCount; ++i)
+		m_workers.emplace_back([this] { WorkerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wakeUpCondition.notify_all();
+
+	for (std::thread& worker : m_workers)
+		worker.join();
+}
+
+unsigned int ThreadPool::GetThreadCount() const
+{
+	return static_cast<unsigned int>(m_workers.size() + 1);
+}
+
+void ThreadPool::ParallelFor(std::size_t count, std::size_t grainSize, const Job& job)
+{
+	if (count == 0)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_activeWorkers = static_cast<unsigned int>(m_workers.size());
+		m_count = count;
+		m_exception = nullptr;
+		m_grainSize = std::max<std::size_t>(grainSize, 1);
+		m_job = &job;
+		m_nextIndex = 0;
+		m_generation++;
+	}
+	m_wakeUpCondition.notify_all();
+
+	ProcessChunks();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this] { return m_activeWorkers == 0; });
+	m_job = nullptr;
+
+	// Une exception levée par un worker est relancée sur le thread appelant
+	if (m_exception)
+		std::rethrow_exception(m_exception);
+}
+
+void ThreadPool::ProcessChunks()
+{
+	// Chaque thread récupère des tranches de grainSize éléments jusqu'à épuisement
+	for (;;)
+	{
+		std::size_t begin = m_nextIndex.fetch_add(m_grainSize);
+		if (begin >= m_count)
+			break;
+
+		try
+		{
+			(*m_job)(begin, std::min(begin + m_grainSize, m_count));
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_exception)
+				m_exception = std::current_exception();
+		}
+	}
+}
+
+void ThreadPool::WorkerLoop()
+{
+	std::size_t lastGeneration = 0;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;)
+	{
+		m_wakeUpCondition.wait(lock, [&] { return m_stop || m_generation != lastGeneration; });
+		if (m_stop)
+			break;
+
+		lastGeneration = m_generation;
+
+		lock.unlock();
+		ProcessChunks();
+		lock.lock();
+
+		if (--m_activeWorkers == 0)
+			m_doneCondition.notify_one();
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads persistants, créés une fois pour toutes afin de ne pas payer la création
+// d'un thread à chaque fois que l'on veut paralléliser une boucle
+class ThreadPool
+{
+public:
+	using Job = std::function<void(std::size_t begin, std::size_t end)>;
+
+	explicit ThreadPool(unsigned int threadCount = std::thread::hardware_concurrency());
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	~ThreadPool();
+
+	unsigned int GetThreadCount() const;
+
+	void ParallelFor(std::size_t count, std::size_t grainSize, const Job& job);
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+
+private:
+	void ProcessChunks();
+	void WorkerLoop();
+
+	std::atomic<std::size_t> m_nextIndex;
+	std::condition_variable m_doneCondition;
+	std::condition_variable m_wakeUpCondition;
+	std::exception_ptr m_exception;
+	std::mutex m_mutex;
+	std::size_t m_count;
+	std::size_t m_generation;
+	std::size_t m_grainSize;
+	std::vector<std::thread> m_workers;
+	const Job* m_job;
+	unsigned int m_activeWorkers;
+	bool m_stop;
+};
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "TimerWheel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+TimerWheel::TimerWheel(float tickDuration) :
+m_currentTick(0),
+m_timerCount(0),
+m_accumulator(0.f),
+m_tickDuration(tickDuration)
+{
+	if (tickDuration <= 0.f)
+		throw std::runtime_error("timer wheel tick duration must be positive");
+
+	m_slots.fill(InvalidIndex);
+}
+
+void TimerWheel::Advance(float elapsedTime)
+{
+	m_accumulator += elapsedTime;
+	while (m_accumulator >= m_tickDuration)
+	{
+		m_accumulator -= m_tickDuration;
+		Tick();
+	}
+}
+
+bool TimerWheel::Cancel(Handle handle)
+{
+	if (handle.index >= m_timers.size())
+		return false;
+
+	Timer& timer = m_timers[handle.index];
+	if (timer.generation != handle.generation)
+		return false;
+
+	switch (timer.state)
+	{
+		case TimerState::Scheduled:
+			Unlink(handle.index);
+			Release(handle.index);
+			return true;
+
+		// La minuterie a expiré mais sa commande n'a pas encore été appliquée : il suffit de l'oublier,
+		// Flush ignorera cette entrée
+		case TimerState::Pending:
+			Release(handle.index);
+			return true;
+
+		case TimerState::Free:
+		default:
+			return false;
+	}
+}
+
+void TimerWheel::Flush(entt::registry& registry)
+{
+	// Une commande peut programmer de nouvelles minuteries (et donc agrandir m_timers),
+	// on travaille sur une copie de la liste et on ne garde aucune référence pendant son exécution
+	std::vector<std::uint32_t> pendingTimers;
+	pendingTimers.swap(m_pendingTimers);
+
+	for (std::uint32_t timerIndex : pendingTimers)
+	{
+		Timer& timer = m_timers[timerIndex];
+		if (timer.state != TimerState::Pending)
+			continue; //< Annulée entre l'expiration et le point de synchronisation
+
+		Command command = std::move(timer.command);
+		entt::entity entity = timer.entity;
+		Release(timerIndex);
+
+		// L'entité a pu être détruite entre-temps (éventuellement par une commande précédente)
+		if (registry.valid(entity))
+			command(registry, entity);
+	}
+
+	// On rend le buffer pour éviter de réallouer à chaque frame
+	pendingTimers.clear();
+	if (m_pendingTimers.empty())
+		m_pendingTimers.swap(pendingTimers);
+}
+
+std::size_t TimerWheel::GetPendingCount() const
+{
+	return m_pendingTimers.size();
+}
+
+float TimerWheel::GetTickDuration() const
+{
+	return m_tickDuration;
+}
+
+std::size_t TimerWheel::GetTimerCount() const
+{
+	return m_timerCount;
+}
+
+TimerWheel::Handle TimerWheel::Schedule(entt::entity entity, float delay, Command command)
+{
+	std::uint32_t timerIndex;
+	if (!m_freeTimers.empty())
+	{
+		timerIndex = m_freeTimers.back();
+		m_freeTimers.pop_back();
+	}
+	else
+	{
+		timerIndex = static_cast<std::uint32_t>(m_timers.size());
+		m_timers.emplace_back();
+	}
+
+	// Une minuterie expire au plus tôt au prochain tick, jamais pendant le tick courant
+	std::uint64_t delayTicks = static_cast<std::uint64_t>(std::ceil(std::max(delay, 0.f) / m_tickDuration));
+
+	Timer& timer = m_timers[timerIndex];
+	timer.command = std::move(command);
+	timer.entity = entity;
+	timer.expiryTick = m_currentTick + std::max<std::uint64_t>(delayTicks, 1);
+	timer.state = TimerState::Scheduled;
+
+	Insert(timerIndex);
+	m_timerCount++;
+
+	Handle handle;
+	handle.index = timerIndex;
+	handle.generation = timer.generation;
+
+	return handle;
+}
+
+TimerWheel::Handle TimerWheel::ScheduleDespawn(entt::entity entity, float delay)
+{
+	return Schedule(entity, delay, [](entt::registry& registry, entt::entity entity)
+	{
+		registry.destroy(entity);
+	});
+}
+
+void TimerWheel::Cascade(unsigned int level)
+{
+	// Les minuteries de cette case expirent dans les 64^level prochains ticks,
+	// on les réinsère pour qu'elles redescendent au niveau correspondant à leur échéance
+	std::uint32_t& slotHead = m_slots[level * SlotCount + ((m_currentTick >> (level * LevelBits)) & (SlotCount - 1))];
+	std::uint32_t timerIndex = std::exchange(slotHead, InvalidIndex);
+	while (timerIndex != InvalidIndex)
+	{
+		std::uint32_t nextIndex = m_timers[timerIndex].next;
+		Insert(timerIndex);
+
+		timerIndex = nextIndex;
+	}
+}
+
+void TimerWheel::Insert(std::uint32_t timerIndex)
+{
+	Timer& timer = m_timers[timerIndex];
+
+	// Le niveau est choisi selon l'écart à l'échéance : < 64 ticks au niveau 0, < 64² au niveau 1, etc.
+	// Au-delà de la capacité de la roue, la minuterie est rangée dans la dernière case atteignable
+	// et sera simplement réinsérée à chaque tour jusqu'à ce que son échéance soit à portée
+	constexpr std::uint64_t MaxDelta = (std::uint64_t(1) << (LevelCount * LevelBits)) - 1;
+	std::uint64_t expiryTick = std::min(timer.expiryTick, m_currentTick + MaxDelta);
+	std::uint64_t delta = expiryTick - m_currentTick;
+
+	unsigned int level = 0;
+	while (level < LevelCount - 1 && delta >= (std::uint64_t(1) << ((level + 1) * LevelBits)))
+		level++;
+
+	std::uint32_t slot = level * SlotCount + static_cast<std::uint32_t>((expiryTick >> (level * LevelBits)) & (SlotCount - 1));
+
+	timer.slot = slot;
+	timer.previous = InvalidIndex;
+	timer.next = m_slots[slot];
+	if (timer.next != InvalidIndex)
+		m_timers[timer.next].previous = timerIndex;
+
+	m_slots[slot] = timerIndex;
+}
+
+void TimerWheel::Release(std::uint32_t timerIndex)
+{
+	Timer& timer = m_timers[timerIndex];
+	timer.command = nullptr;
+	timer.generation++; //< Les handles existants deviennent invalides
+	timer.state = TimerState::Free;
+
+	m_freeTimers.push_back(timerIndex);
+	m_timerCount--;
+}
+
+void TimerWheel::Tick()
+{
+	m_currentTick++;
+
+	// Lorsqu'un niveau fait un tour complet, la case suivante du niveau supérieur redescend d'un cran
+	for (unsigned int level = 1; level < LevelCount; ++level)
+	{
+		if ((m_currentTick & ((std::uint64_t(1) << (level * LevelBits)) - 1)) != 0)
+			break;
+
+		Cascade(level);
+	}
+
+	// Toutes les minuteries de la case courante du premier niveau expirent à ce tick : elles sont déplacées
+	// d'un bloc vers la liste des commandes en attente
+	std::uint32_t& slotHead = m_slots[m_currentTick & (SlotCount - 1)];
+	std::uint32_t timerIndex = std::exchange(slotHead, InvalidIndex);
+	while (timerIndex != InvalidIndex)
+	{
+		Timer& timer = m_timers[timerIndex];
+		timer.state = TimerState::Pending;
+		m_pendingTimers.push_back(timerIndex);
+
+		timerIndex = timer.next;
+	}
+}
+
+void TimerWheel::Unlink(std::uint32_t timerIndex)
+{
+	Timer& timer = m_timers[timerIndex];
+	if (timer.previous != InvalidIndex)
+		m_timers[timer.previous].next = timer.next;
+	else
+		m_slots[timer.slot] = timer.next;
+
+	if (timer.next != InvalidIndex)
+		m_timers[timer.next].previous = timer.previous;
+}
\ No newline at end of file
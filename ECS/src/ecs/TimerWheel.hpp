@@ -0,0 +1,104 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+// Service de minuteries pour les actions différées sur les entités (destruction après N secondes,
+// retour de la gravité après un délai, etc.)
+//
+// Plutôt qu'un composant "compte à rebours" parcouru à chaque frame (coût linéaire en nombre d'entités,
+// même quand rien n'expire), les minuteries sont rangées dans une roue hiérarchique :
+// quatre niveaux de 64 cases, chaque case du niveau N couvrant 64^N ticks.
+// L'insertion et l'annulation sont en O(1), et un tick ne touche que la case courante du premier niveau
+// (plus, tous les 64 ticks, la redescente d'une case du niveau supérieur).
+//
+// Les minuteries expirées ne sont pas exécutées immédiatement : leurs commandes sont mises en attente
+// et appliquées au registre lors de Flush, un point de synchronisation où modifier le registre est sûr.
+class TimerWheel
+{
+public:
+	using Command = std::function<void(entt::registry& registry, entt::entity entity)>;
+
+	struct Handle
+	{
+		std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t generation = 0;
+	};
+
+	TimerWheel(float tickDuration = 1.f / 100.f);
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel(TimerWheel&&) = delete;
+	~TimerWheel() = default;
+
+	void Advance(float elapsedTime);
+
+	bool Cancel(Handle handle);
+
+	void Flush(entt::registry& registry);
+
+	std::size_t GetPendingCount() const;
+	float GetTickDuration() const;
+	std::size_t GetTimerCount() const;
+
+	Handle Schedule(entt::entity entity, float delay, Command command);
+	Handle ScheduleDespawn(entt::entity entity, float delay);
+	template<typename Component> Handle ScheduleRemove(entt::entity entity, float delay);
+
+	TimerWheel& operator=(const TimerWheel&) = delete;
+	TimerWheel& operator=(TimerWheel&&) = delete;
+
+	static constexpr unsigned int LevelBits = 6;
+	static constexpr unsigned int LevelCount = 4;
+	static constexpr unsigned int SlotCount = 1 << LevelBits;
+
+private:
+	static constexpr std::uint32_t InvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+	enum class TimerState
+	{
+		Free,
+		Pending,
+		Scheduled
+	};
+
+	struct Timer
+	{
+		Command command;
+		entt::entity entity;
+		std::uint64_t expiryTick;
+		std::uint32_t generation = 0;
+		std::uint32_t next;
+		std::uint32_t previous;
+		std::uint32_t slot;
+		TimerState state = TimerState::Free;
+	};
+
+	void Cascade(unsigned int level);
+	void Insert(std::uint32_t timerIndex);
+	void Release(std::uint32_t timerIndex);
+	void Tick();
+	void Unlink(std::uint32_t timerIndex);
+
+	std::array<std::uint32_t, LevelCount * SlotCount> m_slots;
+	std::vector<std::uint32_t> m_freeTimers;
+	std::vector<std::uint32_t> m_pendingTimers;
+	std::vector<Timer> m_timers;
+	std::uint64_t m_currentTick;
+	std::size_t m_timerCount;
+	float m_accumulator;
+	float m_tickDuration;
+};
+
+template<typename Component>
+TimerWheel::Handle TimerWheel::ScheduleRemove(entt::entity entity, float delay)
+{
+	return Schedule(entity, delay, [](entt::registry& registry, entt::entity entity)
+	{
+		registry.remove<Component>(entity);
+	});
+}
\ No newline at end of file
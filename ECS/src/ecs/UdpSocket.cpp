@@ -0,0 +1,167 @@
+#include "UdpSocket.hpp"
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <mutex>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+	using NativeSocket = SOCKET;
+	using SocketLength = int;
+
+	void InitializeWinsock()
+	{
+		static std::once_flag initFlag;
+		std::call_once(initFlag, []
+		{
+			WSADATA data;
+			if (WSAStartup(MAKEWORD(2, 2), &data) != 0)
+				throw std::runtime_error("failed to initialize winsock");
+		});
+	}
+
+	// Sous Windows, un datagramme envoyé vers un port fermé fait échouer la réception suivante (WSAECONNRESET)
+	bool IsTransientError()
+	{
+		int error = WSAGetLastError();
+		return error == WSAEWOULDBLOCK || error == WSAECONNRESET;
+	}
+
+	void CloseSocket(std::uintptr_t handle)
+	{
+		closesocket(static_cast<NativeSocket>(handle));
+	}
+#else
+	using NativeSocket = int;
+	using SocketLength = socklen_t;
+
+	bool IsTransientError()
+	{
+		return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+	}
+
+	void CloseSocket(std::uintptr_t handle)
+	{
+		close(static_cast<NativeSocket>(handle));
+	}
+#endif
+
+	sockaddr_in ToSocketAddress(const UdpAddress& address)
+	{
+		sockaddr_in socketAddress = {};
+		socketAddress.sin_family = AF_INET;
+		socketAddress.sin_addr.s_addr = htonl(address.ip);
+		socketAddress.sin_port = htons(address.port);
+
+		return socketAddress;
+	}
+}
+
+UdpAddress UdpAddress::Loopback(std::uint16_t port)
+{
+	UdpAddress address;
+	address.ip = INADDR_LOOPBACK;
+	address.port = port;
+
+	return address;
+}
+
+UdpSocket::UdpSocket(std::uint16_t port)
+{
+#ifdef _WIN32
+	InitializeWinsock();
+
+	SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (handle == INVALID_SOCKET)
+		throw std::runtime_error("failed to create UDP socket");
+#else
+	int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (handle < 0)
+		throw std::runtime_error("failed to create UDP socket");
+#endif
+
+	m_handle = static_cast<std::uintptr_t>(handle);
+
+	// Les fragments d'un gros snapshot arrivent en rafale : un buffer de réception confortable évite d'en perdre
+	int bufferSize = 4 * 1024 * 1024;
+	setsockopt(handle, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+	setsockopt(handle, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+
+	sockaddr_in socketAddress = ToSocketAddress(UdpAddress::Loopback(port));
+	if (bind(handle, reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0)
+	{
+		CloseSocket(m_handle);
+		throw std::runtime_error("failed to bind UDP socket on port " + std::to_string(port));
+	}
+
+#ifdef _WIN32
+	u_long nonBlocking = 1;
+	ioctlsocket(handle, FIONBIO, &nonBlocking);
+#else
+	fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+#endif
+}
+
+UdpSocket::~UdpSocket()
+{
+	CloseSocket(m_handle);
+}
+
+UdpAddress UdpSocket::GetLocalAddress() const
+{
+	sockaddr_in socketAddress = {};
+	SocketLength length = sizeof(socketAddress);
+	getsockname(static_cast<NativeSocket>(m_handle), reinterpret_cast<sockaddr*>(&socketAddress), &length);
+
+	UdpAddress address;
+	address.ip = ntohl(socketAddress.sin_addr.s_addr);
+	address.port = ntohs(socketAddress.sin_port);
+
+	return address;
+}
+
+bool UdpSocket::Receive(std::vector<std::uint8_t>& buffer, UdpAddress& sender)
+{
+	buffer.resize(MaxDatagramSize);
+
+	sockaddr_in socketAddress = {};
+	SocketLength length = sizeof(socketAddress);
+	auto received = recvfrom(static_cast<NativeSocket>(m_handle), reinterpret_cast<char*>(buffer.data()), static_cast<int>(buffer.size()), 0, reinterpret_cast<sockaddr*>(&socketAddress), &length);
+	if (received < 0)
+	{
+		if (IsTransientError())
+			return false;
+
+		throw std::runtime_error("failed to receive UDP datagram");
+	}
+
+	buffer.resize(static_cast<std::size_t>(received));
+	sender.ip = ntohl(socketAddress.sin_addr.s_addr);
+	sender.port = ntohs(socketAddress.sin_port);
+
+	return true;
+}
+
+void UdpSocket::Send(const UdpAddress& address, const void* data, std::size_t size)
+{
+	if (size > MaxDatagramSize)
+		throw std::runtime_error("UDP datagram is too large");
+
+	sockaddr_in socketAddress = ToSocketAddress(address);
+
+	// UDP ne garantit rien : un datagramme perdu (buffer plein...) est simplement ignoré, le protocole au-dessus s'en accommode
+	sendto(static_cast<NativeSocket>(m_handle), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress));
+}
\ No newline at end of file
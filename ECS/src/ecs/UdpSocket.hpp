@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct UdpAddress
+{
+	std::uint32_t ip = 0;   //< Dans l'ordre des octets de la machine
+	std::uint16_t port = 0;
+
+	bool operator==(const UdpAddress& other) const { return ip == other.ip && port == other.port; }
+	bool operator!=(const UdpAddress& other) const { return !(*this == other); }
+
+	static UdpAddress Loopback(std::uint16_t port);
+};
+
+// Socket UDP non bloquante, liée à l'interface locale (127.0.0.1)
+class UdpSocket
+{
+public:
+	UdpSocket(std::uint16_t port = 0);
+	UdpSocket(const UdpSocket&) = delete;
+	UdpSocket(UdpSocket&&) = delete;
+	~UdpSocket();
+
+	UdpAddress GetLocalAddress() const;
+
+	bool Receive(std::vector<std::uint8_t>& buffer, UdpAddress& sender);
+
+	void Send(const UdpAddress& address, const void* data, std::size_t size);
+
+	UdpSocket& operator=(const UdpSocket&) = delete;
+	UdpSocket& operator=(UdpSocket&&) = delete;
+
+	static constexpr std::size_t MaxDatagramSize = 65507;
+
+private:
+	std::uintptr_t m_handle;
+};
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Components.hpp"
+#include <entt/entt.hpp>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// L'horloge de mise à jour retient la durée des dernières frames, afin qu'une entité mise à jour
+// toutes les N frames avance du temps réellement écoulé depuis sa dernière mise à jour
+class UpdateClock
+{
+public:
+	static constexpr unsigned int MaxPeriod = UpdateEvery8Frames::Period;
+
+	void Advance(float elapsedTime)
+	{
+		++m_frameIndex;
+		m_frameTimes[m_frameIndex % MaxPeriod] = elapsedTime;
+	}
+
+	// Temps écoulé sur les "period" dernières frames
+	float GetElapsedTime(unsigned int period) const
+	{
+		float elapsedTime = 0.f;
+		for (unsigned int i = 0; i < period; ++i)
+			elapsedTime += m_frameTimes[(m_frameIndex - i) % MaxPeriod];
+
+		return elapsedTime;
+	}
+
+	// Phase de la frame en cours : les entités d'un bucket de cette période mises à jour pendant cette frame sont celles de cette phase.
+	// Une entité rangée dans un bucket avec cette phase sera donc mise à jour exactement "period" frames plus tard
+	unsigned int GetCurrentPhase(unsigned int period) const
+	{
+		return static_cast<unsigned int>(m_frameIndex % period);
+	}
+
+private:
+	std::array<float, MaxPeriod> m_frameTimes = {};
+	Uint64 m_frameIndex = 0;
+};
+
+template<typename Bucket, unsigned int... Phases>
+void RemoveUpdatePhases(entt::registry& registry, entt::entity entity, std::integer_sequence<unsigned int, Phases...>)
+{
+	registry.remove<UpdatePhase<Bucket, Phases>...>(entity);
+}
+
+template<typename Bucket, unsigned int... Phases>
+void EmplaceUpdatePhase(entt::registry& registry, entt::entity entity, unsigned int phase, std::integer_sequence<unsigned int, Phases...>)
+{
+	((Phases == phase ? static_cast<void>(registry.emplace<UpdatePhase<Bucket, Phases>>(entity)) : void()), ...);
+}
+
+template<typename Bucket, unsigned int... Phases>
+unsigned int FindUpdatePhase(const entt::registry& registry, entt::entity entity, std::integer_sequence<unsigned int, Phases...>)
+{
+	unsigned int phase = 0;
+	((registry.all_of<UpdatePhase<Bucket, Phases>>(entity) ? (phase = Phases, void()) : void()), ...);
+
+	return phase;
+}
+
+// Retire l'entité de son bucket et de sa phase
+inline void RemoveUpdateBucket(entt::registry& registry, entt::entity entity)
+{
+	registry.remove<UpdateEveryFrame, UpdateEvery2Frames, UpdateEvery8Frames>(entity);
+	RemoveUpdatePhases<UpdateEvery2Frames>(registry, entity, std::make_integer_sequence<unsigned int, UpdateEvery2Frames::Period>{});
+	RemoveUpdatePhases<UpdateEvery8Frames>(registry, entity, std::make_integer_sequence<unsigned int, UpdateEvery8Frames::Period>{});
+}
+
+// Range l'entité dans le bucket de période "period" (1, 2 ou 8) avec la phase donnée, à la place de son bucket actuel.
+// Avec UpdateClock::GetCurrentPhase(period) pour une entité mise à jour pendant cette frame, sa prochaine mise à jour a lieu
+// exactement "period" frames plus tard, et GetElapsedTime(period) est bien le temps écoulé depuis
+inline void SetUpdateBucket(entt::registry& registry, entt::entity entity, unsigned int period, unsigned int phase)
+{
+	RemoveUpdateBucket(registry, entity);
+
+	switch (period)
+	{
+		case UpdateEveryFrame::Period:
+			registry.emplace<UpdateEveryFrame>(entity);
+			break;
+
+		case UpdateEvery2Frames::Period:
+			registry.emplace<UpdateEvery2Frames>(entity);
+			EmplaceUpdatePhase<UpdateEvery2Frames>(registry, entity, phase % period, std::make_integer_sequence<unsigned int, UpdateEvery2Frames::Period>{});
+			break;
+
+		case UpdateEvery8Frames::Period:
+			registry.emplace<UpdateEvery8Frames>(entity);
+			EmplaceUpdatePhase<UpdateEvery8Frames>(registry, entity, phase % period, std::make_integer_sequence<unsigned int, UpdateEvery8Frames::Period>{});
+			break;
+
+		default:
+			throw std::runtime_error("invalid update bucket period " + std::to_string(period));
+	}
+}
+
+// Phase de l'entité dans son bucket (0 pour UpdateEveryFrame ou sans bucket)
+inline unsigned int GetUpdatePhase(const entt::registry& registry, entt::entity entity)
+{
+	if (registry.all_of<UpdateEvery2Frames>(entity))
+		return FindUpdatePhase<UpdateEvery2Frames>(registry, entity, std::make_integer_sequence<unsigned int, UpdateEvery2Frames::Period>{});
+	else if (registry.all_of<UpdateEvery8Frames>(entity))
+		return FindUpdatePhase<UpdateEvery8Frames>(registry, entity, std::make_integer_sequence<unsigned int, UpdateEvery8Frames::Period>{});
+	else
+		return 0;
+}
+
+// Appelle func(entity, elapsedTime, composants...) pour chaque entité du bucket devant être mise à jour cette frame :
+// seule la vue de la phase en cours est parcourue, une entité d'un bucket de 8 frames ne coûte donc qu'une fois sur huit
+template<typename Bucket, typename... Components, typename... Excludes, typename Func>
+void ForEachDueInBucket(entt::registry& registry, const UpdateClock& clock, entt::exclude_t<Excludes...> exclude, Func&& func)
+{
+	float elapsedTime = clock.GetElapsedTime(Bucket::Period);
+
+	auto ForEachInView = [&](auto view)
+	{
+		for (entt::entity entity : view)
+			func(entity, elapsedTime, view.template get<Components>(entity)...);
+	};
+
+	if constexpr (Bucket::Period == 1)
+		ForEachInView(registry.view<Components..., Bucket>(exclude));
+	else
+	{
+		unsigned int currentPhase = clock.GetCurrentPhase(Bucket::Period);
+		[&]<unsigned int... Phases>(std::integer_sequence<unsigned int, Phases...>)
+		{
+			((Phases == currentPhase ? ForEachInView(registry.view<Components..., UpdatePhase<Bucket, Phases>>(exclude)) : void()), ...);
+		}(std::make_integer_sequence<unsigned int, Bucket::Period>{});
+	}
+}
+
+template<typename... Components, typename... Excludes, typename Func>
+void ForEachDue(entt::registry& registry, const UpdateClock& clock, entt::exclude_t<Excludes...> exclude, Func&& func)
+{
+	ForEachDueInBucket<UpdateEveryFrame, Components...>(registry, clock, exclude, func);
+	ForEachDueInBucket<UpdateEvery2Frames, Components...>(registry, clock, exclude, func);
+	ForEachDueInBucket<UpdateEvery8Frames, Components...>(registry, clock, exclude, func);
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "VirtualArena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+	// Granularité d'engagement de la mémoire sous Windows (Linux engage page par page au premier accès)
+	constexpr std::size_t CommitGranularity = 1024 * 1024;
+#endif
+
+	// En dessous de cette taille, il n'est pas rentable de rendre la mémoire d'un bloc libéré au système
+	constexpr std::size_t DiscardThreshold = 64 * 1024;
+
+	std::size_t AlignUp(std::size_t value, std::size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+VirtualArena::VirtualArena(std::size_t reservedSize, bool useHugePages) :
+m_committedSize(0),
+m_offset(0),
+m_usedSize(0),
+m_useHugePages(useHugePages)
+{
+	// On réserve une page énorme de plus pour pouvoir aligner le début de l'arène sur 2 Mo
+	m_reservedSize = AlignUp(reservedSize, HugePageSize);
+	m_mappingSize = m_reservedSize + HugePageSize;
+
+#ifdef _WIN32
+	m_useHugePages = false;
+
+	m_mapping = static_cast<std::byte*>(VirtualAlloc(nullptr, m_mappingSize, MEM_RESERVE, PAGE_NOACCESS));
+	if (!m_mapping)
+		throw std::runtime_error("failed to reserve virtual memory");
+#else
+	// MAP_NORESERVE : aucune mémoire n'est engagée tant que les pages ne sont pas touchées
+	void* mapping = mmap(nullptr, m_mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (mapping == MAP_FAILED)
+		throw std::runtime_error("failed to reserve virtual memory");
+
+	m_mapping = static_cast<std::byte*>(mapping);
+#endif
+
+	m_base = m_mapping + (AlignUp(reinterpret_cast<std::uintptr_t>(m_mapping), HugePageSize) - reinterpret_cast<std::uintptr_t>(m_mapping));
+
+#if defined(MADV_HUGEPAGE)
+	// Simple conseil au noyau : si les transparent huge pages sont désactivées, l'arène fonctionne avec des pages normales
+	if (m_useHugePages && madvise(m_base, m_reservedSize, MADV_HUGEPAGE) != 0)
+		m_useHugePages = false;
+#elif !defined(_WIN32)
+	m_useHugePages = false;
+#endif
+}
+
+VirtualArena::~VirtualArena()
+{
+#ifdef _WIN32
+	VirtualFree(m_mapping, 0, MEM_RELEASE);
+#else
+	munmap(m_mapping, m_mappingSize);
+#endif
+}
+
+void* VirtualArena::Allocate(std::size_t size, std::size_t alignment)
+{
+	std::size_t sizeClass = GetSizeClass(std::max(size, alignment));
+	std::size_t blockSize = MinBlockSize << sizeClass;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::vector<std::byte*>& freeBlocks = m_freeBlocks[sizeClass];
+	if (!freeBlocks.empty())
+	{
+		std::byte* block = freeBlocks.back();
+		freeBlocks.pop_back();
+
+		m_usedSize += blockSize;
+		return block;
+	}
+
+	// Les blocs sont alignés sur leur propre taille (jusqu'à 2 Mo), ce qui satisfait tout alignement demandé
+	// et permet au noyau de couvrir les gros blocs avec des pages énormes
+	std::size_t offset = AlignUp(m_offset, std::min(blockSize, HugePageSize));
+	if (offset + blockSize > m_reservedSize)
+		throw std::bad_alloc();
+
+#ifdef _WIN32
+	if (offset + blockSize > m_committedSize)
+	{
+		std::size_t newCommittedSize = AlignUp(offset + blockSize, CommitGranularity);
+		if (!VirtualAlloc(m_base + m_committedSize, newCommittedSize - m_committedSize, MEM_COMMIT, PAGE_READWRITE))
+			throw std::bad_alloc();
+
+		m_committedSize = newCommittedSize;
+	}
+#endif
+
+	m_offset = offset + blockSize;
+	m_usedSize += blockSize;
+
+	return m_base + offset;
+}
+
+void VirtualArena::Deallocate(void* pointer, std::size_t size, std::size_t alignment)
+{
+	if (!pointer)
+		return;
+
+	std::size_t sizeClass = GetSizeClass(std::max(size, alignment));
+	std::size_t blockSize = MinBlockSize << sizeClass;
+
+	// Le bloc reste réservé pour être recyclé, mais sa mémoire physique est rendue au système
+	if (blockSize >= DiscardThreshold)
+	{
+#ifdef _WIN32
+		VirtualAlloc(pointer, blockSize, MEM_RESET, PAGE_READWRITE);
+#else
+		madvise(pointer, blockSize, MADV_DONTNEED);
+#endif
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_freeBlocks[sizeClass].push_back(static_cast<std::byte*>(pointer));
+	m_usedSize -= blockSize;
+}
+
+std::size_t VirtualArena::GetAllocatedSize() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_offset;
+}
+
+std::size_t VirtualArena::GetReservedSize() const
+{
+	return m_reservedSize;
+}
+
+std::size_t VirtualArena::GetUsedSize() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_usedSize;
+}
+
+bool VirtualArena::UsesHugePages() const
+{
+	return m_useHugePages;
+}
+
+std::size_t VirtualArena::GetSizeClass(std::size_t size)
+{
+	std::size_t sizeClass = 0;
+	while ((MinBlockSize << sizeClass) < size)
+	{
+		if (++sizeClass >= SizeClassCount)
+			throw std::bad_alloc();
+	}
+
+	return sizeClass;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Arène de mémoire virtuelle destinée aux pools de composants du registre
+//
+// Une plage d'adresses est réservée d'un bloc à la construction (plusieurs gigaoctets ne coûtent rien tant qu'ils
+// ne sont pas touchés) : la mémoire physique n'est engagée qu'au fur et à mesure que les pages sont utilisées.
+// Réserver d'avance la capacité d'un pool pour des millions d'entités ne coûte donc que de l'espace d'adressage,
+// et le pool n'a plus jamais à se réallouer (ni à recopier ses composants) en grandissant.
+//
+// Les blocs sont arrondis à la puissance de deux supérieure et recyclés via une liste libre par taille ;
+// les gros blocs libérés rendent leur mémoire physique au système.
+// Sous Linux, les transparent huge pages (pages de 2 Mo) peuvent être demandées pour réduire la pression sur le TLB
+// lors du parcours de grands pools. Elles sont ignorées sous Windows, où les large pages ne peuvent pas être engagées à la demande.
+class VirtualArena
+{
+public:
+	VirtualArena(std::size_t reservedSize, bool useHugePages = false);
+	VirtualArena(const VirtualArena&) = delete;
+	VirtualArena(VirtualArena&&) = delete;
+	~VirtualArena();
+
+	void* Allocate(std::size_t size, std::size_t alignment);
+
+	void Deallocate(void* pointer, std::size_t size, std::size_t alignment);
+
+	std::size_t GetAllocatedSize() const;
+	std::size_t GetReservedSize() const;
+	std::size_t GetUsedSize() const;
+
+	bool UsesHugePages() const;
+
+	VirtualArena& operator=(const VirtualArena&) = delete;
+	VirtualArena& operator=(VirtualArena&&) = delete;
+
+	static constexpr std::size_t HugePageSize = 2 * 1024 * 1024;
+	static constexpr std::size_t MinBlockSize = 64;
+
+private:
+	static constexpr std::size_t SizeClassCount = 48;
+
+	static std::size_t GetSizeClass(std::size_t size);
+
+	std::array<std::vector<std::byte*>, SizeClassCount> m_freeBlocks;
+	mutable std::mutex m_mutex;
+	std::byte* m_base;
+	std::byte* m_mapping;
+	std::size_t m_committedSize; //< Uniquement sous Windows
+	std::size_t m_mappingSize;
+	std::size_t m_offset;
+	std::size_t m_reservedSize;
+	std::size_t m_usedSize;
+	bool m_useHugePages;
+};
\ No newline at end of file
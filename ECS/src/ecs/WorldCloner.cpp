@@ -0,0 +1,23 @@
+#include "WorldCloner.hpp"
+
+void WorldCloner::Clone(entt::registry& source, entt::registry& destination) const
+{
+	// Vider le registre ne libère pas la mémoire de ses pools, un registre réutilisé ne réalloue donc rien
+	destination.clear();
+
+	// On recréé les entités avec le même identifiant que dans le monde source, en parcourant une seule fois son stockage d'entités
+	// (qui ne contient que des entités valides) : le registre de destination venant d'être vidé, aucune vérification n'est nécessaire
+	for (auto [entity] : source.storage<entt::entity>().each())
+		destination.create(entity);
+
+	for (const Pool& pool : m_pools)
+		pool.copy(source, destination);
+}
+
+void WorldCloner::Reserve(entt::registry& destination, std::size_t entityCount) const
+{
+	destination.storage<entt::entity>().reserve(entityCount);
+
+	for (const Pool& pool : m_pools)
+		pool.reserve(destination, entityCount);
+}
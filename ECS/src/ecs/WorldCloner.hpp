@@ -0,0 +1,67 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Copie un monde (registre) vers un second registre, typiquement préalloué et réutilisé d'un clonage à l'autre,
+// pour simuler quelques centaines de ticks "pour voir" (IA, outils what-if) puis jeter le résultat.
+// Toutes les entités sont recréées avec leur identifiant, en une seule passe sur le stockage des entités du monde source,
+// puis seuls les types de composants enregistrés sont copiés, pool par pool.
+// Les ressources partagées (comme les textures des Drawable, via std::shared_ptr) ne sont pas dupliquées mais partagées.
+class WorldCloner
+{
+public:
+	WorldCloner() = default;
+	WorldCloner(const WorldCloner&) = default;
+	WorldCloner(WorldCloner&&) = default;
+	~WorldCloner() = default;
+
+	void Clone(entt::registry& source, entt::registry& destination) const;
+
+	template<typename Component> void Register();
+
+	void Reserve(entt::registry& destination, std::size_t entityCount) const;
+
+	WorldCloner& operator=(const WorldCloner&) = default;
+	WorldCloner& operator=(WorldCloner&&) = default;
+
+private:
+	template<typename Component> static void CopyPool(entt::registry& source, entt::registry& destination);
+	template<typename Component> static void ReservePool(entt::registry& registry, std::size_t entityCount);
+
+	struct Pool
+	{
+		void(*copy)(entt::registry& source, entt::registry& destination);
+		void(*reserve)(entt::registry& registry, std::size_t entityCount);
+	};
+
+	std::vector<Pool> m_pools;
+};
+
+template<typename Component>
+void WorldCloner::Register()
+{
+	Pool& pool = m_pools.emplace_back();
+	pool.copy = &CopyPool<Component>;
+	pool.reserve = &ReservePool<Component>;
+}
+
+template<typename Component>
+void WorldCloner::CopyPool(entt::registry& source, entt::registry& destination)
+{
+	// Copie en bloc de toute la pool : les entités et les composants sont parcourus dans le même ordre,
+	// ce qui permet de tout insérer en un seul appel (pour un type trivialement copiable, ce n'est qu'une suite de copies mémoire)
+	auto view = source.view<Component>();
+	if constexpr (std::is_empty_v<Component>)
+		destination.insert<Component>(view.begin(), view.end());
+	else
+		destination.insert<Component>(view.begin(), view.end(), source.storage<Component>().begin());
+}
+
+template<typename Component>
+void WorldCloner::ReservePool(entt::registry& registry, std::size_t entityCount)
+{
+	registry.storage<Component>().reserve(entityCount);
+}
\ No newline at end of file
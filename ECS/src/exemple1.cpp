@@ -1,3 +1,4 @@
+#include "ecs/ComponentIndex.hpp"
 #include <entt/entt.hpp>
 #include <iostream>
 
@@ -19,6 +20,10 @@ int main()
 	// Le centre d'un ECS est son registre, aussi appel "world" dans certaines implmentations.
 	// C'est lui qui contient toutes les entits et leurs composants
 	entt::registry registry;
+
+	// Un index permet de retrouver une entit  partir de la valeur d'un de ses composants (ici son nom)
+	// sans parcourir toutes les entits, il se tient  jour tout seul en coutant le registre
+	ComponentIndex<std::string> names(registry);
 	
 	// On cr une premire entit, dans un ECS une entit n'est rien d'autre qu'un nombre
 	entt::entity firstEntity = registry.create();
@@ -44,6 +49,14 @@ int main()
 	// Attention: un ECS peut dplacer nos composants en mmoire  sa guise, nous ne devons pas conserver de rfrence sur les composants
 	//  la place nous devons toujours le rcuprer au moment d'agir dessus
 
+	// Retrouver "l'entit nomme Albert" est maintenant immdiat, quel que soit le nombre d'entits
+	entt::entity albert = names.Find("Albert");
+	if (albert != entt::null)
+		std::cout << "Albert is entity #" << entt::to_integral(albert) << std::endl;
+
+	// Pour que l'index reste  jour, un nom doit tre modifi via replace (ou patch) qui prviennent le registre
+	registry.replace<std::string>(secondEntity, "Jean-Pierre");
+
 	// On se sert d'une boucle pour faire avancer le temps dans notre programme
 	for (unsigned int i = 0; i < 100; ++i)
 	{
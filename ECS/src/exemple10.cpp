@@ -0,0 +1,300 @@
+// Simulation d'un monde découpé en tranches verticales (shards), chacune simulée par son propre processus, sans fenêtre ni renderer
+// Les shards voisins sont reliés par des sockets UNIX : à chaque tick ils échangent les entités qui changent de shard
+// et les fantômes de leurs zones frontalières, ce qui permet de compter les contacts entre entités de part et d'autre d'une frontière.
+// Le même monde est d'abord simulé dans un seul processus, pour vérifier que le découpage donne exactement le même résultat.
+
+#include "ecs/Components.hpp"
+#include "ecs/SpatialShard.hpp"
+#include "ecs/Systems.hpp"
+#include "ecs/UpdateClock.hpp"
+#include <entt/entt.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+const unsigned int ShardCount = 4;
+const unsigned int EntityCount = 200'000;
+const unsigned int TickCount = 200;
+const float TickDuration = 1.f / 60.f;
+const float WorldWidth = 8192.f;
+const float WorldHeight = 2048.f;
+const float MaxSpeed = 300.f;     //< Soit 5 pixels par tick au plus, bien moins que la largeur d'un shard
+const float ContactRadius = 4.f;
+const float GhostWidth = 16.f;    //< Doit couvrir le rayon de contact plus le déplacement d'un tick
+
+struct ShardResult
+{
+	std::uint64_t contactCount = 0;
+	std::uint64_t entityCount = 0;
+	std::uint64_t migratedCount = 0;
+	double tickTime = 0.0;
+};
+
+void SpawnEntities(entt::registry& registry, float minX, float maxX)
+{
+	// Tous les shards tirent le même monde (même graine) et ne gardent que les entités de leur tranche
+	std::mt19937 randomEngine(42);
+	std::uniform_real_distribution<float> xDistribution(0.f, WorldWidth);
+	std::uniform_real_distribution<float> yDistribution(0.f, WorldHeight);
+	std::uniform_real_distribution<float> speedDistribution(-MaxSpeed, MaxSpeed);
+
+	for (unsigned int i = 0; i < EntityCount; ++i)
+	{
+		Position pos{ xDistribution(randomEngine), yDistribution(randomEngine) };
+		Velocity vel{ speedDistribution(randomEngine), speedDistribution(randomEngine) };
+		if (pos.x < minX || pos.x >= maxX)
+			continue;
+
+		entt::entity entity = registry.create();
+		registry.emplace<Position>(entity, pos);
+		registry.emplace<Velocity>(entity, vel);
+		registry.emplace<NoGravity>(entity);
+		registry.emplace<UpdateEveryFrame>(entity);
+	}
+}
+
+// Les entités rebondissent sur les bords du monde
+void BounceSystem(entt::registry& registry)
+{
+	auto view = registry.view<Position, Velocity>(entt::exclude<Ghost>);
+	for (entt::entity entity : view)
+	{
+		auto& pos = view.get<Position>(entity);
+		auto& vel = view.get<Velocity>(entity);
+
+		if (pos.x < 0.f || pos.x >= WorldWidth)
+		{
+			pos.x = std::clamp(pos.x, 0.f, std::nextafter(WorldWidth, 0.f));
+			vel.x = -vel.x;
+		}
+
+		if (pos.y < 0.f || pos.y >= WorldHeight)
+		{
+			pos.y = std::clamp(pos.y, 0.f, std::nextafter(WorldHeight, 0.f));
+			vel.y = -vel.y;
+		}
+	}
+}
+
+// Compte, pour chaque entité possédée par le shard, les entités (possédées ou fantômes) à moins de ContactRadius
+std::uint64_t CountContacts(entt::registry& registry, float minX, float maxX)
+{
+	struct Point
+	{
+		float x;
+		float y;
+		bool owned;
+	};
+
+	// Grille de cellules de la taille du rayon de contact, remplie par un tri par comptage
+	int gridWidth = static_cast<int>(std::ceil((maxX - minX) / ContactRadius)) + 1;
+	int gridHeight = static_cast<int>(std::ceil(WorldHeight / ContactRadius)) + 1;
+
+	auto GetCell = [&](float x, float y)
+	{
+		int cellX = std::clamp(static_cast<int>((x - minX) / ContactRadius), 0, gridWidth - 1);
+		int cellY = std::clamp(static_cast<int>(y / ContactRadius), 0, gridHeight - 1);
+		return cellY * gridWidth + cellX;
+	};
+
+	std::vector<Point> points;
+	auto view = registry.view<Position>();
+	for (entt::entity entity : view)
+	{
+		const auto& pos = view.get<Position>(entity);
+		points.push_back(Point{ pos.x, pos.y, !registry.all_of<Ghost>(entity) });
+	}
+
+	std::vector<unsigned int> cellStarts(static_cast<std::size_t>(gridWidth) * gridHeight + 1, 0);
+	for (const Point& point : points)
+		cellStarts[GetCell(point.x, point.y) + 1]++;
+
+	for (std::size_t i = 1; i < cellStarts.size(); ++i)
+		cellStarts[i] += cellStarts[i - 1];
+
+	std::vector<unsigned int> insertOffsets(cellStarts.begin(), cellStarts.end() - 1);
+	std::vector<Point> sortedPoints(points.size());
+	for (const Point& point : points)
+		sortedPoints[insertOffsets[GetCell(point.x, point.y)]++] = point;
+
+	std::uint64_t contactCount = 0;
+	for (const Point& point : sortedPoints)
+	{
+		if (!point.owned)
+			continue;
+
+		int cellX = std::clamp(static_cast<int>((point.x - minX) / ContactRadius), 0, gridWidth - 1);
+		int cellY = std::clamp(static_cast<int>(point.y / ContactRadius), 0, gridHeight - 1);
+
+		for (int y = std::max(cellY - 1, 0); y <= std::min(cellY + 1, gridHeight - 1); ++y)
+		{
+			for (int x = std::max(cellX - 1, 0); x <= std::min(cellX + 1, gridWidth - 1); ++x)
+			{
+				int cell = y * gridWidth + x;
+				for (unsigned int i = cellStarts[cell]; i < cellStarts[cell + 1]; ++i)
+				{
+					float dx = sortedPoints[i].x - point.x;
+					float dy = sortedPoints[i].y - point.y;
+					float distanceSq = dx * dx + dy * dy;
+					if (distanceSq > 0.f && distanceSq < ContactRadius * ContactRadius)
+						contactCount++;
+				}
+			}
+		}
+	}
+
+	return contactCount;
+}
+
+ShardResult RunShard(float minX, float maxX, int leftSocket, int rightSocket)
+{
+	entt::registry registry;
+	SpawnEntities(registry, minX, maxX);
+
+	SpatialShard shard(registry, minX, maxX, GhostWidth, leftSocket, rightSocket);
+	UpdateClock clock;
+
+	ShardResult result;
+
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int tick = 0; tick < TickCount; ++tick)
+	{
+		clock.Advance(TickDuration);
+
+		VelocitySystem(registry, clock);
+		BounceSystem(registry);
+
+		// Point de synchronisation avec les shards voisins : migrations et fantômes
+		shard.Exchange();
+
+		result.contactCount += CountContacts(registry, minX - GhostWidth, maxX + GhostWidth);
+	}
+	result.tickTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / TickCount;
+
+	auto ownedView = registry.view<Position>(entt::exclude<Ghost>);
+	result.entityCount = static_cast<std::uint64_t>(std::distance(ownedView.begin(), ownedView.end()));
+	result.migratedCount = shard.GetMigratedCount();
+
+	return result;
+}
+
+int main()
+{
+	std::cout << "Simulating " << EntityCount << " entities for " << TickCount << " ticks" << std::endl;
+
+	// Référence : tout le monde dans un seul processus
+	ShardResult reference = RunShard(0.f, WorldWidth, -1, -1);
+	std::cout << "Single process: " << reference.tickTime << "ms per tick, " << reference.contactCount << " contacts" << std::endl;
+
+	// Une paire de sockets par frontière, et un pipe par shard pour remonter son résultat
+	std::vector<int> borderSockets(2 * (ShardCount - 1));
+	for (unsigned int i = 0; i < ShardCount - 1; ++i)
+	{
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, &borderSockets[2 * i]) != 0)
+		{
+			std::cerr << "failed to create shard sockets" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::vector<int> resultPipes(2 * ShardCount);
+	std::vector<pid_t> children;
+	for (unsigned int shardIndex = 0; shardIndex < ShardCount; ++shardIndex)
+	{
+		if (pipe(&resultPipes[2 * shardIndex]) != 0)
+		{
+			std::cerr << "failed to create result pipe" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		pid_t pid = fork();
+		if (pid < 0)
+		{
+			std::cerr << "failed to fork shard process" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if (pid == 0)
+		{
+			// Processus du shard : il ne garde que ses deux sockets de frontière
+			int leftSocket = (shardIndex > 0) ? borderSockets[2 * (shardIndex - 1) + 1] : -1;
+			int rightSocket = (shardIndex < ShardCount - 1) ? borderSockets[2 * shardIndex] : -1;
+			for (int socket : borderSockets)
+			{
+				if (socket != leftSocket && socket != rightSocket)
+					close(socket);
+			}
+
+			close(resultPipes[2 * shardIndex]);
+
+			int exitCode = EXIT_SUCCESS;
+			try
+			{
+				float shardWidth = WorldWidth / ShardCount;
+				ShardResult result = RunShard(shardIndex * shardWidth, (shardIndex + 1) * shardWidth, leftSocket, rightSocket);
+				if (write(resultPipes[2 * shardIndex + 1], &result, sizeof(result)) != sizeof(result))
+					exitCode = EXIT_FAILURE;
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "shard #" << shardIndex << ": " << e.what() << std::endl;
+				exitCode = EXIT_FAILURE;
+			}
+
+			_exit(exitCode);
+		}
+
+		close(resultPipes[2 * shardIndex + 1]);
+		children.push_back(pid);
+	}
+
+	// Le processus parent n'a plus besoin des sockets de frontière
+	for (int socket : borderSockets)
+		close(socket);
+
+	ShardResult total;
+	double slowestTickTime = 0.0;
+	bool success = true;
+	for (unsigned int shardIndex = 0; shardIndex < ShardCount; ++shardIndex)
+	{
+		ShardResult result;
+		if (read(resultPipes[2 * shardIndex], &result, sizeof(result)) != sizeof(result))
+		{
+			success = false;
+			continue;
+		}
+
+		close(resultPipes[2 * shardIndex]);
+
+		std::cout << "Shard #" << shardIndex << ": " << result.entityCount << " entities, " << result.migratedCount << " migrations, " << result.tickTime << "ms per tick" << std::endl;
+
+		total.contactCount += result.contactCount;
+		total.entityCount += result.entityCount;
+		slowestTickTime = std::max(slowestTickTime, result.tickTime);
+	}
+
+	for (pid_t child : children)
+	{
+		int status;
+		waitpid(child, &status, 0);
+	}
+
+	if (!success)
+	{
+		std::cerr << "a shard process failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << ShardCount << " shards: " << slowestTickTime << "ms per tick (slowest shard), " << total.contactCount << " contacts, " << total.entityCount << " entities" << std::endl;
+	std::cout << (total.contactCount == reference.contactCount && total.entityCount == EntityCount ? "Sharded result matches the single process" : "Sharded result differs from the single process") << std::endl;
+
+	return 0;
+}
\ No newline at end of file
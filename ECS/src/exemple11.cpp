@@ -0,0 +1,277 @@
+// Réplication d'un registre d'un processus à un autre via UDP sur la machine locale
+//
+// exemple11 server : simulation sans fenêtre de balles qui tombent, rebondissent et disparaissent au bout de quelques secondes
+// exemple11 client : affiche dans une fenêtre les entités répliquées depuis le serveur
+// exemple11        : le serveur et le client dans le même processus, pour mesurer le nombre d'octets envoyés par entité
+
+#include "ecs/Components.hpp"
+#include "ecs/Replication.hpp"
+#include "ecs/Systems.hpp"
+#include "ecs/TimerWheel.hpp"
+#include "ecs/UdpSocket.hpp"
+#include "ecs/UpdateClock.hpp"
+#include "sdlcpp/SDLpp.hpp"
+#include "sdlcpp/SDLppRenderer.hpp"
+#include "sdlcpp/SDLppTexture.hpp"
+#include "sdlcpp/SDLppTextureCache.hpp"
+#include "sdlcpp/SDLppWindow.hpp"
+#include <entt/entt.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+
+const std::uint16_t ServerPort = 27015;
+const unsigned int BenchmarkEntityCount = 10'000;
+const unsigned int BenchmarkTickCount = 600;
+const unsigned int DemoEntityCount = 2'000;
+const float TickDuration = 1.f / 60.f;
+const float WorldWidth = 1280.f;
+const float WorldHeight = 720.f;
+
+// Simulation côté serveur : des balles lancées en l'air, soumises à la gravité, qui disparaissent au bout de quelques secondes
+class BallSimulation
+{
+public:
+	BallSimulation(entt::registry& registry, unsigned int entityCount) :
+	m_registry(registry),
+	m_randomEngine(42),
+	m_entityCount(entityCount)
+	{
+	}
+
+	void Step()
+	{
+		// On remplace les balles ayant disparu
+		std::size_t activeCount = m_registry.view<Position>().size();
+		for (std::size_t i = activeCount; i < m_entityCount; ++i)
+			SpawnBall();
+
+		m_clock.Advance(TickDuration);
+		GravitySystem(m_registry, m_clock);
+		VelocitySystem(m_registry, m_clock);
+
+		// Les balles rebondissent sur le sol et les murs en perdant un peu d'énergie
+		auto view = m_registry.view<Position, Velocity>();
+		for (entt::entity entity : view)
+		{
+			auto& pos = view.get<Position>(entity);
+			auto& vel = view.get<Velocity>(entity);
+
+			if (pos.y > WorldHeight)
+			{
+				pos.y = WorldHeight;
+				vel.y = -std::abs(vel.y) * 0.8f;
+			}
+
+			if (pos.x < 0.f || pos.x > WorldWidth)
+			{
+				pos.x = std::clamp(pos.x, 0.f, WorldWidth);
+				vel.x = -vel.x;
+			}
+		}
+
+		m_timerWheel.Advance(TickDuration);
+		m_timerWheel.Flush(m_registry);
+	}
+
+private:
+	void SpawnBall()
+	{
+		std::uniform_real_distribution<float> xDistribution(0.f, WorldWidth);
+		std::uniform_real_distribution<float> speedDistribution(-300.f, 300.f);
+		std::uniform_real_distribution<float> lifetimeDistribution(2.f, 10.f);
+
+		entt::entity entity = m_registry.create();
+		m_registry.emplace<Position>(entity, xDistribution(m_randomEngine), WorldHeight);
+		m_registry.emplace<Velocity>(entity, speedDistribution(m_randomEngine), -1000.f + speedDistribution(m_randomEngine));
+		m_registry.emplace<UpdateEveryFrame>(entity);
+
+		m_timerWheel.ScheduleDespawn(entity, lifetimeDistribution(m_randomEngine));
+	}
+
+	entt::registry& m_registry;
+	std::mt19937 m_randomEngine;
+	TimerWheel m_timerWheel;
+	UpdateClock m_clock;
+	unsigned int m_entityCount;
+};
+
+int RunBenchmark()
+{
+	entt::registry serverRegistry;
+	entt::registry clientRegistry;
+
+	UdpSocket serverSocket;
+	UdpSocket clientSocket;
+
+	ReplicationServer server(serverSocket);
+	ReplicationClient client(clientSocket, serverSocket.GetLocalAddress());
+
+	BallSimulation simulation(serverRegistry, BenchmarkEntityCount);
+
+	// Le client s'annonce au serveur
+	client.Update(clientRegistry);
+
+	std::size_t firstSnapshotBytes = 0;
+	std::size_t steadyBytes = 0;
+	std::size_t steadyEntities = 0;
+	unsigned int appliedCount = 0;
+	float maxPositionError = 0.f;
+	float maxVelocityError = 0.f;
+
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int tick = 0; tick < BenchmarkTickCount; ++tick)
+	{
+		simulation.Step();
+
+		std::size_t sentBytes = server.Update(serverRegistry);
+
+		// Sur la boucle locale, les datagrammes sont déjà arrivés
+		if (client.Update(clientRegistry))
+			appliedCount++;
+
+		std::size_t entityCount = serverRegistry.view<Position>().size();
+		if (tick == 0)
+			firstSnapshotBytes = sentBytes;
+		else
+		{
+			steadyBytes += sentBytes;
+			steadyEntities += entityCount;
+		}
+
+		// L'état client doit correspondre à l'état serveur, à la quantification près
+		auto view = serverRegistry.view<Position, Velocity>();
+		for (entt::entity entity : view)
+		{
+			entt::entity clientEntity = client.FindEntity(entt::to_integral(entity));
+			if (clientEntity == entt::null)
+			{
+				std::cerr << "entity #" << entt::to_integral(entity) << " was not replicated" << std::endl;
+				return EXIT_FAILURE;
+			}
+
+			const auto& serverPos = view.get<Position>(entity);
+			const auto& serverVel = view.get<Velocity>(entity);
+			const auto& clientPos = clientRegistry.get<Position>(clientEntity);
+			const auto& clientVel = clientRegistry.get<Velocity>(clientEntity);
+
+			maxPositionError = std::max({ maxPositionError, std::abs(serverPos.x - clientPos.x), std::abs(serverPos.y - clientPos.y) });
+			maxVelocityError = std::max({ maxVelocityError, std::abs(serverVel.x - clientVel.x), std::abs(serverVel.y - clientVel.y) });
+		}
+
+		if (clientRegistry.view<Position>().size() != entityCount)
+		{
+			std::cerr << "client has " << clientRegistry.view<Position>().size() << " entities instead of " << entityCount << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	double elapsedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	// Sans réplication incrémentale, chaque entité coûterait son identifiant plus quatre floats à chaque tick
+	constexpr std::size_t RawEntitySize = sizeof(std::uint32_t) + sizeof(Position) + sizeof(Velocity);
+
+	std::cout << BenchmarkEntityCount << " entities, " << BenchmarkTickCount << " ticks, " << appliedCount << " snapshots applied (" << elapsedTime / BenchmarkTickCount << "ms per tick)" << std::endl;
+	std::cout << "Raw state: " << RawEntitySize << " bytes per entity" << std::endl;
+	std::cout << "Full snapshot: " << static_cast<double>(firstSnapshotBytes) / BenchmarkEntityCount << " bytes per entity" << std::endl;
+	std::cout << "Delta snapshots: " << static_cast<double>(steadyBytes) / steadyEntities << " bytes per entity per tick (" << steadyBytes / (BenchmarkTickCount - 1) / 1024 << " KiB per tick)" << std::endl;
+	std::cout << "Max error: " << maxPositionError << " px on positions, " << maxVelocityError << " px/s on velocities" << std::endl;
+
+	return 0;
+}
+
+int RunServer()
+{
+	entt::registry registry;
+
+	UdpSocket socket(ServerPort);
+	ReplicationServer server(socket);
+
+	BallSimulation simulation(registry, DemoEntityCount);
+
+	std::cout << "Listening on port " << ServerPort << std::endl;
+
+	std::size_t sentBytes = 0;
+	unsigned int tick = 0;
+
+	// Boucle à pas fixe, sans rendu
+	auto nextTick = std::chrono::steady_clock::now();
+	for (;;)
+	{
+		simulation.Step();
+		sentBytes += server.Update(registry);
+
+		if (++tick % 60 == 0 && server.HasClient())
+		{
+			std::cout << "Sent " << sentBytes / 1024 << " KiB/s (" << static_cast<double>(sentBytes) / (60 * DemoEntityCount) << " bytes per entity per tick)" << std::endl;
+			sentBytes = 0;
+		}
+
+		nextTick += std::chrono::microseconds(static_cast<long long>(TickDuration * 1'000'000));
+		std::this_thread::sleep_until(nextTick);
+	}
+}
+
+int RunClient()
+{
+	SDLpp sdl;
+
+	SDLppWindow window("Client", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, static_cast<int>(WorldWidth), static_cast<int>(WorldHeight));
+	SDLppRenderer renderer = window.CreateRenderer(SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+
+	SDLppTextureCache textureCache(renderer, 16 * 1024 * 1024);
+
+	entt::registry registry;
+
+	UdpSocket socket;
+
+	// Le serveur ne réplique que l'état physique : c'est au client de décider comment afficher les entités qui apparaissent
+	ReplicationClient client(socket, UdpAddress::Loopback(ServerPort), [&](entt::registry& registry, entt::entity entity)
+	{
+		auto& entityDrawable = registry.emplace<Drawable>(entity);
+		entityDrawable.width = 16;
+		entityDrawable.height = 16;
+		entityDrawable.texture = textureCache.Load("resources/circle.png");
+	});
+
+	bool running = true;
+	while (running)
+	{
+		SDL_Event event;
+		while (sdl.PollEvent(event))
+		{
+			if (event.type == SDL_QUIT)
+				running = false;
+		}
+
+		client.Update(registry);
+
+		renderer.SetDrawColor(0, 0, 0);
+		renderer.Clear();
+		RenderSystem(registry, renderer);
+		renderer.Present();
+	}
+
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		if (argc > 1 && std::strcmp(argv[1], "server") == 0)
+			return RunServer();
+		else if (argc > 1 && std::strcmp(argv[1], "client") == 0)
+			return RunClient();
+		else
+			return RunBenchmark();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
\ No newline at end of file
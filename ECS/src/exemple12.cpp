@@ -0,0 +1,168 @@
+// Affichage de nombreux sprites différents, chacun dans sa propre texture ou tous rangés dans un atlas
+// Avec une texture par sprite, le renderer en change presque à chaque entité et ne peut rien regrouper ;
+// avec l'atlas, toutes les entités partagent la même texture et SDL regroupe les affichages.
+// Espace bascule entre les deux modes, le temps moyen d'une frame est affiché chaque seconde.
+
+#include "ecs/Components.hpp"
+#include "ecs/Systems.hpp"
+#include "sdlcpp/SDLpp.hpp"
+#include "sdlcpp/SDLppRenderer.hpp"
+#include "sdlcpp/SDLppSurface.hpp"
+#include "sdlcpp/SDLppTexture.hpp"
+#include "sdlcpp/SDLppTextureAtlas.hpp"
+#include "sdlcpp/SDLppWindow.hpp"
+#include <entt/entt.hpp>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+const unsigned int EntityCount = 20'000;
+const unsigned int GeneratedSpriteCount = 62;
+
+struct Sprite
+{
+	std::size_t index;
+};
+
+// Un carré de couleur avec une bordure, en guise de sprite
+SDLppSurface GenerateSprite(int size, Uint8 r, Uint8 g, Uint8 b)
+{
+	SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+	if (!surface)
+		throw std::runtime_error(std::string("failed to create surface: ") + SDL_GetError());
+
+	SDL_FillRect(surface, nullptr, SDL_MapRGBA(surface->format, r / 2, g / 2, b / 2, 255));
+
+	SDL_Rect inner = { 2, 2, size - 4, size - 4 };
+	SDL_FillRect(surface, &inner, SDL_MapRGBA(surface->format, r, g, b, 255));
+
+	return SDLppSurface(surface);
+}
+
+int main()
+{
+	try
+	{
+		SDLpp sdl;
+
+		SDLppWindow window("Atlas", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1280, 720);
+		SDLppRenderer renderer = window.CreateRenderer(SDL_RENDERER_ACCELERATED);
+
+		std::mt19937 randomEngine(42);
+
+		// Les images des sprites : celles du jeu et des carrés générés
+		std::vector<SDLppSurface> surfaces;
+		surfaces.push_back(SDLppSurface::FromFile("resources/circle.png"));
+		surfaces.push_back(SDLppSurface::FromFile("resources/player.png"));
+
+		std::uniform_int_distribution<int> sizeDistribution(8, 64);
+		std::uniform_int_distribution<int> colorDistribution(64, 255);
+		for (unsigned int i = 0; i < GeneratedSpriteCount; ++i)
+			surfaces.push_back(GenerateSprite(sizeDistribution(randomEngine), colorDistribution(randomEngine), colorDistribution(randomEngine), colorDistribution(randomEngine)));
+
+		// Une texture par sprite...
+		std::vector<std::shared_ptr<SDLppTexture>> textures;
+		for (const SDLppSurface& surface : surfaces)
+			textures.push_back(SDLppTexture::FromSurface(renderer, surface));
+
+		// ... ou un atlas regroupant tous les sprites
+		SDLppTextureAtlasBuilder atlasBuilder;
+		for (SDLppSurface& surface : surfaces)
+			atlasBuilder.Add(std::move(surface));
+
+		std::vector<SDLppAtlasRegion> regions = atlasBuilder.Build(renderer);
+
+		entt::registry registry;
+
+		std::uniform_real_distribution<float> xDistribution(0.f, 1280.f);
+		std::uniform_real_distribution<float> yDistribution(0.f, 720.f);
+		std::uniform_int_distribution<std::size_t> spriteDistribution(0, textures.size() - 1);
+		for (unsigned int i = 0; i < EntityCount; ++i)
+		{
+			entt::entity entity = registry.create();
+
+			auto& entityPos = registry.emplace<Position>(entity);
+			entityPos.x = xDistribution(randomEngine);
+			entityPos.y = yDistribution(randomEngine);
+
+			std::size_t spriteIndex = spriteDistribution(randomEngine);
+			registry.emplace<Sprite>(entity, spriteIndex);
+
+			auto& entityDrawable = registry.emplace<Drawable>(entity);
+			entityDrawable.width = 24;
+			entityDrawable.height = 24;
+			entityDrawable.texture = textures[spriteIndex];
+		}
+
+		bool useAtlas = false;
+		auto UpdateDrawables = [&]
+		{
+			auto view = registry.view<Sprite, Drawable>();
+			for (entt::entity entity : view)
+			{
+				std::size_t spriteIndex = view.get<Sprite>(entity).index;
+
+				auto& entityDrawable = view.get<Drawable>(entity);
+				if (useAtlas)
+				{
+					entityDrawable.texture = regions[spriteIndex].texture;
+					entityDrawable.sourceRect = regions[spriteIndex].rect;
+				}
+				else
+				{
+					entityDrawable.texture = textures[spriteIndex];
+					entityDrawable.sourceRect = SDL_Rect{ 0, 0, 0, 0 };
+				}
+			}
+
+			std::cout << (useAtlas ? "Drawing from the atlas" : "Drawing from separate textures") << std::endl;
+		};
+		UpdateDrawables();
+
+		Uint64 freq = sdl.GetPerformanceFrequency();
+		Uint64 lastReport = sdl.GetPerformanceCounter();
+		unsigned int frameCount = 0;
+
+		bool running = true;
+		while (running)
+		{
+			SDL_Event event;
+			while (sdl.PollEvent(event))
+			{
+				if (event.type == SDL_QUIT)
+					running = false;
+				else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE)
+				{
+					useAtlas = !useAtlas;
+					UpdateDrawables();
+				}
+			}
+
+			renderer.SetDrawColor(0, 0, 0);
+			renderer.Clear();
+			RenderSystem(registry, renderer);
+			renderer.Present();
+
+			frameCount++;
+
+			Uint64 now = sdl.GetPerformanceCounter();
+			if (now - lastReport >= freq)
+			{
+				double elapsedTime = static_cast<double>(now - lastReport) / static_cast<double>(freq);
+				std::cout << elapsedTime * 1000.0 / frameCount << "ms per frame" << std::endl;
+
+				lastReport = now;
+				frameCount = 0;
+			}
+		}
+
+		return 0;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
\ No newline at end of file
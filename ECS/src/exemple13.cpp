@@ -0,0 +1,157 @@
+// Un écran presque immobile (comme un éditeur) : des milliers de sprites fixes et quelques-uns qui se déplacent.
+// Par défaut, seules les zones où un sprite a bougé sont redessinées (DirtyRectRenderer) ;
+// Espace bascule vers le rendu classique (Clear puis RenderSystem), le temps moyen d'une frame est affiché chaque seconde.
+// Lancé avec "software", le programme utilise le renderer logiciel de SDL, où la différence est la plus marquée.
+
+#include "ecs/Components.hpp"
+#include "ecs/DirtyRectRenderer.hpp"
+#include "ecs/Systems.hpp"
+#include "sdlcpp/SDLpp.hpp"
+#include "sdlcpp/SDLppRenderer.hpp"
+#include "sdlcpp/SDLppTexture.hpp"
+#include "sdlcpp/SDLppWindow.hpp"
+#include <entt/entt.hpp>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+const unsigned int StaticEntityCount = 20'000;
+const unsigned int MovingEntityCount = 10;
+
+// Les sprites mobiles tournent autour d'un point
+struct Orbit
+{
+	float centerX;
+	float centerY;
+	float radius;
+	float angle;
+};
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		SDLpp sdl;
+
+		bool software = argc > 1 && std::strcmp(argv[1], "software") == 0;
+
+		SDLppWindow window("Dirty rectangles", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1280, 720);
+		SDLppRenderer renderer = window.CreateRenderer((software) ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED);
+
+		std::shared_ptr<SDLppTexture> circleTexture = SDLppTexture::FromFile(renderer, "resources/circle.png");
+		std::shared_ptr<SDLppTexture> playerTexture = SDLppTexture::FromFile(renderer, "resources/player.png");
+
+		entt::registry registry;
+
+		std::mt19937 randomEngine(42);
+		std::uniform_real_distribution<float> xDistribution(0.f, 1280.f);
+		std::uniform_real_distribution<float> yDistribution(0.f, 720.f);
+		std::uniform_int_distribution<int> sizeDistribution(8, 32);
+		for (unsigned int i = 0; i < StaticEntityCount; ++i)
+		{
+			entt::entity entity = registry.create();
+
+			auto& entityPos = registry.emplace<Position>(entity);
+			entityPos.x = xDistribution(randomEngine);
+			entityPos.y = yDistribution(randomEngine);
+
+			auto& entityDrawable = registry.emplace<Drawable>(entity);
+			entityDrawable.width = sizeDistribution(randomEngine);
+			entityDrawable.height = entityDrawable.width;
+			entityDrawable.texture = circleTexture;
+		}
+
+		std::uniform_real_distribution<float> radiusDistribution(20.f, 100.f);
+		for (unsigned int i = 0; i < MovingEntityCount; ++i)
+		{
+			entt::entity entity = registry.create();
+			registry.emplace<Position>(entity);
+			registry.emplace<Orbit>(entity, xDistribution(randomEngine), yDistribution(randomEngine), radiusDistribution(randomEngine), 0.f);
+
+			auto& entityDrawable = registry.emplace<Drawable>(entity);
+			entityDrawable.width = 32;
+			entityDrawable.height = 32;
+			entityDrawable.texture = playerTexture;
+		}
+
+		DirtyRectRenderer dirtyRects(registry, renderer);
+		bool useDirtyRects = true;
+
+		Uint64 freq = sdl.GetPerformanceFrequency();
+		Uint64 lastUpdate = sdl.GetPerformanceCounter();
+		Uint64 lastReport = lastUpdate;
+		unsigned int frameCount = 0;
+		std::size_t redrawnArea = 0;
+
+		bool running = true;
+		while (running)
+		{
+			Uint64 now = sdl.GetPerformanceCounter();
+			float elapsedTime = static_cast<float>(now - lastUpdate) / freq;
+			lastUpdate = now;
+
+			SDL_Event event;
+			while (sdl.PollEvent(event))
+			{
+				if (event.type == SDL_QUIT)
+					running = false;
+				else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_SPACE)
+				{
+					useDirtyRects = !useDirtyRects;
+
+					// Ce qui a été affiché entre-temps ne passe pas par la texture du DirtyRectRenderer
+					dirtyRects.Invalidate();
+
+					std::cout << (useDirtyRects ? "Redrawing dirty rectangles only" : "Redrawing everything") << std::endl;
+				}
+			}
+
+			auto view = registry.view<Position, Orbit>();
+			for (entt::entity entity : view)
+			{
+				auto& entityPos = view.get<Position>(entity);
+				auto& entityOrbit = view.get<Orbit>(entity);
+
+				entityOrbit.angle += elapsedTime;
+				entityPos.x = entityOrbit.centerX + std::cos(entityOrbit.angle) * entityOrbit.radius;
+				entityPos.y = entityOrbit.centerY + std::sin(entityOrbit.angle) * entityOrbit.radius;
+			}
+
+			if (useDirtyRects)
+			{
+				dirtyRects.Render();
+				redrawnArea += dirtyRects.GetRedrawnArea();
+			}
+			else
+			{
+				renderer.SetDrawColor(0, 0, 0);
+				renderer.Clear();
+				RenderSystem(registry, renderer);
+				redrawnArea += 1280 * 720;
+			}
+
+			renderer.Present();
+
+			frameCount++;
+
+			if (now - lastReport >= freq)
+			{
+				double reportTime = static_cast<double>(now - lastReport) / static_cast<double>(freq);
+				std::cout << reportTime * 1000.0 / frameCount << "ms per frame, " << redrawnArea * 100 / (frameCount * 1280 * 720) << "% of the screen redrawn" << std::endl;
+
+				lastReport = now;
+				frameCount = 0;
+				redrawnArea = 0;
+			}
+		}
+
+		return 0;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+// Composition de miniatures sur le CPU, sans fenêtre ni renderer : des centaines de sprites semi-transparents mélangés dans une surface,
+// d'abord avec SDL_BlitSurface / SDL_BlitScaled, puis avec SDLppSurface::Blit / BlitScaled pour chaque version des noyaux (scalaire, SSE2, AVX2).
+// Le programme affiche le temps de composition d'une miniature et le débit en pixels mélangés,
+// puis vérifie que toutes les versions des noyaux produisent exactement la même image et l'écart maximal avec celle de SDL.
+
+#include "sdlcpp/SDLppSurface.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+const int ThumbnailSize = 256;
+const int SpriteSize = 64;
+const int ScaledSpriteSize = 40;
+const unsigned int SpriteCount = 400;
+const unsigned int ThumbnailCount = 50;
+
+struct Placement
+{
+	std::size_t sprite;
+	int x;
+	int y;
+};
+
+struct Sprite
+{
+	SDLppSurface straight;
+	SDLppSurface premultiplied;
+};
+
+Uint32& GetPixel(SDL_Surface* surface, int x, int y)
+{
+	return reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch)[x];
+}
+
+// Disque de couleur uniforme, opaque au centre et s'estompant vers ses bords, dont les coins sont transparents : le cas typique d'un sprite
+Sprite GenerateSprite(std::mt19937& randomEngine)
+{
+	std::uniform_int_distribution<int> colorDistribution(0, 255);
+	Uint8 r = static_cast<Uint8>(colorDistribution(randomEngine));
+	Uint8 g = static_cast<Uint8>(colorDistribution(randomEngine));
+	Uint8 b = static_cast<Uint8>(colorDistribution(randomEngine));
+
+	Sprite sprite = { SDLppSurface::Create(SpriteSize, SpriteSize), SDLppSurface::Create(SpriteSize, SpriteSize) };
+	SDL_Surface* straight = sprite.straight.GetHandle();
+	SDL_Surface* premultiplied = sprite.premultiplied.GetHandle();
+
+	for (int y = 0; y < SpriteSize; ++y)
+	{
+		for (int x = 0; x < SpriteSize; ++x)
+		{
+			float dx = x + 0.5f - SpriteSize / 2.f;
+			float dy = y + 0.5f - SpriteSize / 2.f;
+			float distance = std::sqrt(dx * dx + dy * dy) / (SpriteSize / 2.f);
+			float coverage = std::clamp((1.f - distance) * 3.f, 0.f, 1.f);
+
+			Uint8 a = static_cast<Uint8>(coverage * 255.f + 0.5f);
+			GetPixel(straight, x, y) = SDL_MapRGBA(straight->format, r, g, b, a);
+			GetPixel(premultiplied, x, y) = SDL_MapRGBA(premultiplied->format, static_cast<Uint8>(r * a / 255), static_cast<Uint8>(g * a / 255), static_cast<Uint8>(b * a / 255), a);
+		}
+	}
+
+	return sprite;
+}
+
+// Exécute compose ThumbnailCount fois et affiche le temps moyen et le débit (pixels de sprites mélangés par seconde)
+template<typename F>
+void Measure(const std::string& name, std::size_t blendedPixels, F&& compose)
+{
+	// Une première composition hors mesure, pour que les caches et la conversion éventuelle des surfaces ne faussent pas le résultat
+	compose();
+
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < ThumbnailCount; ++i)
+		compose();
+
+	double elapsedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ThumbnailCount;
+	std::cout << "  " << name << ": " << elapsedTime << "ms per thumbnail, " << blendedPixels / (elapsedTime * 1000.0) << " Mpixels/s" << std::endl;
+}
+
+int MaxDifference(SDL_Surface* first, SDL_Surface* second)
+{
+	int maxDifference = 0;
+	for (int y = 0; y < first->h; ++y)
+	{
+		for (int x = 0; x < first->w; ++x)
+		{
+			Uint32 firstPixel = GetPixel(first, x, y);
+			Uint32 secondPixel = GetPixel(second, x, y);
+			for (int shift = 0; shift < 32; shift += 8)
+				maxDifference = std::max(maxDifference, std::abs(static_cast<int>((firstPixel >> shift) & 0xFF) - static_cast<int>((secondPixel >> shift) & 0xFF)));
+		}
+	}
+
+	return maxDifference;
+}
+
+int main()
+{
+	try
+	{
+		std::mt19937 randomEngine(42);
+
+		std::vector<Sprite> sprites;
+		for (unsigned int i = 0; i < 16; ++i)
+			sprites.push_back(GenerateSprite(randomEngine));
+
+		for (Sprite& sprite : sprites)
+			SDL_SetSurfaceBlendMode(sprite.straight.GetHandle(), SDL_BLENDMODE_BLEND);
+
+		std::uniform_int_distribution<std::size_t> spriteDistribution(0, sprites.size() - 1);
+		std::uniform_int_distribution<int> positionDistribution(-SpriteSize / 2, ThumbnailSize - SpriteSize / 2);
+
+		std::vector<Placement> placements(SpriteCount);
+		for (Placement& placement : placements)
+			placement = { spriteDistribution(randomEngine), positionDistribution(randomEngine), positionDistribution(randomEngine) };
+
+		const SDL_Color background = { 40, 40, 48, 255 };
+		const std::size_t blitPixels = std::size_t(SpriteCount) * SpriteSize * SpriteSize;
+		const std::size_t scaledPixels = std::size_t(SpriteCount) * ScaledSpriteSize * ScaledSpriteSize;
+
+		SDLppSurface sdlThumbnail = SDLppSurface::Create(ThumbnailSize, ThumbnailSize);
+		SDLppSurface sdlScaledThumbnail = SDLppSurface::Create(ThumbnailSize, ThumbnailSize);
+		SDL_Surface* sdlHandle = sdlThumbnail.GetHandle();
+		SDL_Surface* sdlScaledHandle = sdlScaledThumbnail.GetHandle();
+		Uint32 backgroundPixel = SDL_MapRGBA(sdlHandle->format, background.r, background.g, background.b, background.a);
+
+		std::cout << "SDL" << std::endl;
+		Measure("SDL_BlitSurface", blitPixels, [&]
+		{
+			SDL_FillRect(sdlHandle, nullptr, backgroundPixel);
+			for (const Placement& placement : placements)
+			{
+				SDL_Rect dstRect = { placement.x, placement.y, SpriteSize, SpriteSize };
+				SDL_BlitSurface(sprites[placement.sprite].straight.GetHandle(), nullptr, sdlHandle, &dstRect);
+			}
+		});
+
+		Measure("SDL_BlitScaled", scaledPixels, [&]
+		{
+			SDL_FillRect(sdlScaledHandle, nullptr, backgroundPixel);
+			for (const Placement& placement : placements)
+			{
+				SDL_Rect dstRect = { placement.x, placement.y, ScaledSpriteSize, ScaledSpriteSize };
+				SDL_BlitScaled(sprites[placement.sprite].straight.GetHandle(), nullptr, sdlScaledHandle, &dstRect);
+			}
+		});
+
+		const std::pair<SDLppBlitBackend, const char*> backends[] = {
+			{ SDLppBlitBackend::Scalar, "Scalar" },
+			{ SDLppBlitBackend::SSE2, "SSE2" },
+			{ SDLppBlitBackend::AVX2, "AVX2" }
+		};
+
+		SDLppBlitBackend defaultBackend = SDLppSurface::GetBlitBackend();
+
+		// Images obtenues avec la version scalaire, auxquelles les autres versions sont comparées
+		std::vector<SDLppSurface> referenceThumbnails;
+		bool identical = true;
+
+		for (const auto& [backend, backendName] : backends)
+		{
+			if (!SDLppSurface::SetBlitBackend(backend))
+			{
+				std::cout << backendName << ": not supported by this CPU" << std::endl;
+				continue;
+			}
+
+			std::vector<SDLppSurface> thumbnails;
+			for (unsigned int i = 0; i < 3; ++i)
+				thumbnails.push_back(SDLppSurface::Create(ThumbnailSize, ThumbnailSize));
+
+			std::cout << backendName << std::endl;
+			Measure("Blit (straight alpha)", blitPixels, [&]
+			{
+				thumbnails[0].Fill(background);
+				for (const Placement& placement : placements)
+					thumbnails[0].Blit(sprites[placement.sprite].straight, placement.x, placement.y);
+			});
+
+			Measure("Blit (premultiplied alpha)", blitPixels, [&]
+			{
+				thumbnails[1].Fill(background);
+				for (const Placement& placement : placements)
+					thumbnails[1].Blit(sprites[placement.sprite].premultiplied, placement.x, placement.y, SDLppAlphaMode::Premultiplied);
+			});
+
+			Measure("BlitScaled (straight alpha)", scaledPixels, [&]
+			{
+				thumbnails[2].Fill(background);
+				for (const Placement& placement : placements)
+					thumbnails[2].BlitScaled(sprites[placement.sprite].straight, SDL_Rect{ placement.x, placement.y, ScaledSpriteSize, ScaledSpriteSize });
+			});
+
+			if (referenceThumbnails.empty())
+			{
+				std::cout << "  difference with SDL_BlitSurface: " << MaxDifference(thumbnails[0].GetHandle(), sdlHandle) << ", with SDL_BlitScaled: " << MaxDifference(thumbnails[2].GetHandle(), sdlScaledHandle) << std::endl;
+				referenceThumbnails = std::move(thumbnails);
+			}
+			else
+			{
+				for (std::size_t i = 0; i < thumbnails.size(); ++i)
+				{
+					if (MaxDifference(thumbnails[i].GetHandle(), referenceThumbnails[i].GetHandle()) != 0)
+						identical = false;
+				}
+			}
+		}
+
+		SDLppSurface::SetBlitBackend(defaultBackend);
+
+		std::cout << ((identical) ? "All backends produce identical thumbnails" : "Backends produce different thumbnails!") << std::endl;
+
+		return (identical) ? 0 : EXIT_FAILURE;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
\ No newline at end of file
@@ -1,47 +1,32 @@
+#include "ecs/Behaviour.hpp"
+#include "ecs/Components.hpp"
+#include "ecs/FlowField.hpp"
+#include "ecs/MemoryReporter.hpp"
+#include "ecs/SystemScheduler.hpp"
+#include "ecs/Systems.hpp"
+#include "ecs/TimerWheel.hpp"
+#include "ecs/UpdateClock.hpp"
 #include "sdlcpp/SDLpp.hpp"
 #include "sdlcpp/SDLppFont.hpp"
+#include "sdlcpp/SDLppGlyphAtlas.hpp"
+#include "sdlcpp/SDLppRenderTarget.hpp"
 #include "sdlcpp/SDLppRenderer.hpp"
+#include "sdlcpp/SDLppSdfFont.hpp"
 #include "sdlcpp/SDLppSurface.hpp"
+#include "sdlcpp/SDLppTextCache.hpp"
+#include "sdlcpp/SDLppTextLayout.hpp"
 #include "sdlcpp/SDLppTexture.hpp"
+#include "sdlcpp/SDLppTextureCache.hpp"
 #include "sdlcpp/SDLppTTF.hpp"
 #include "sdlcpp/SDLppWindow.hpp"
 #include <entt/entt.hpp>
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <string>
 
-struct Position
-{
-	float x = 0.f;
-	float y = 0.f;
-};
-
-struct Velocity
-{
-	float x = 0.f;
-	float y = 0.f;
-};
-
-struct Drawable
-{
-	int width;
-	int height;
-	std::shared_ptr<SDLppTexture> texture;
-};
-
-struct NoGravity {};
-
-struct Input
-{
-	bool left = false;
-	bool right = false;
-	bool up = false;
-	bool down = false;
-};
-
-void PlayerControllerSystem(entt::registry& registry);
-void InputSystem(const SDLpp& sdl, entt::registry& registry);
-void GravitySystem(entt::registry& registry, float elapsedTime);
-void RenderSystem(entt::registry& registry, SDLppRenderer& renderer);
-void VelocitySystem(entt::registry& registry, float elapsedTime);
+Behaviour SpawnerBehaviour(entt::registry& registry, TimerWheel& timerWheel, entt::entity entity, std::shared_ptr<SDLppTexture> circleTexture);
 
 int main()
 {
@@ -52,26 +37,43 @@ int main()
 		SDLppWindow window("Ma super fenétre", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1280, 720);
 		SDLppRenderer renderer = window.CreateRenderer(SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
 
-		// On charge la texture des cercles que nous allons afficher dans un std::shared_ptr
+		// Les textures passent par un cache : une image demandée plusieurs fois n'est chargée qu'une fois,
+		// et les textures inutilisées sont libérées au-delà de 64 Mio
+		SDLppTextureCache textureCache(renderer, 64 * 1024 * 1024);
+
+		// On récupère la texture des cercles que nous allons afficher dans un std::shared_ptr
 		// afin de pouvoir la partager ensuite entre nos entités cercles
-		std::shared_ptr<SDLppTexture> circleTexture = SDLppTexture::FromFile(renderer, "resources/circle.png");
+		std::shared_ptr<SDLppTexture> circleTexture = textureCache.Load("resources/circle.png");
+
+		// Le texte de l'interface change à chaque frame : plutôt que de rastériser une nouvelle surface à chaque fois,
+		// il est affiché à partir d'un atlas des glyphes de la police, rempli au fur et à mesure.
+		// Sa taille est réglable (F3 / F4) : les glyphes de chaque taille sont tirés des champs de distance d'une seule police
+		SDLppTTF ttf;
+		SDLppFont hudFont("resources/coolvetica.ttf", 20);
+		SDLppFont hudReferenceFont("resources/coolvetica.ttf", 64);
+		SDLppSdfFont hudSdfFont(renderer, hudReferenceFont);
+		int hudSize = 24;
+
+		// Les textes qui ne changent pas d'une frame à l'autre (aide, libellés) ne sont rendus qu'une fois, puis retrouvés dans un cache
+		SDLppTextCache textCache(renderer, 4 * 1024 * 1024);
+
+		// Journal des actions, en bas à droite : chaque nouvelle ligne est mise en page une seule fois, quelle que soit la taille du journal
+		SDLppGlyphAtlas logGlyphs(renderer, hudFont);
+		SDLppTextLayout eventLog(logGlyphs, 320, SDLppTextAlignment::Right);
 
 		entt::registry registry;
 
 		// On créé une entité joueur (présente dés le début) avec des composants particuliers
 		entt::entity player = registry.create();
+
+		// Son image est décodée en arrière-plan sans bloquer la boucle : il ne sera affiché qu'une fois sa texture prête
+		std::future<std::shared_ptr<SDLppTexture>> playerTexture = renderer.LoadTextureAsync("resources/player.png");
 		{
 			// Une position de départ
 			auto& entityPos = registry.emplace<Position>(player);
 			entityPos.x = 200.f;
 			entityPos.y = 200.f;
 
-			// Une façon de l'afficher
-			auto& entityDrawable = registry.emplace<Drawable>(player);
-			entityDrawable.width = 640.f / 5.f;
-			entityDrawable.height = 427.f / 5.f;
-			entityDrawable.texture = SDLppTexture::FromFile(renderer, "resources/player.png");
-
 			// Une vélocité
 			auto& entityVelocity = registry.emplace<Velocity>(player);
 			entityVelocity.x = 0.f;
@@ -82,8 +84,117 @@ int main()
 
 			// Nous voulons pouvoir le contréler
 			registry.emplace<Input>(player);
+
+			// Le joueur est évidemment toujours mis à jour à chaque frame
+			registry.emplace<UpdateEveryFrame>(player);
 		}
 
+		// Les actions différées (destruction d'une entité, retour de la gravité...) passent par une roue de minuteries
+		// plutôt que par un compte à rebours par entité parcouru à chaque frame
+		TimerWheel timerWheel;
+
+		// Une entité "lanceuse" dont le comportement est scripté par une coroutine
+		BehaviourScheduler behaviourScheduler(registry);
+
+		entt::entity spawner = registry.create();
+		{
+			auto& entityPos = registry.emplace<Position>(spawner);
+			entityPos.x = 900.f;
+			entityPos.y = 100.f;
+
+			auto& entityDrawable = registry.emplace<Drawable>(spawner);
+			entityDrawable.width = 64;
+			entityDrawable.height = 64;
+			entityDrawable.texture = circleTexture;
+
+			registry.emplace<Velocity>(spawner);
+			registry.emplace<NoGravity>(spawner);
+			registry.emplace<UpdateEveryFrame>(spawner);
+
+			behaviourScheduler.Start(spawner, SpawnerBehaviour(registry, timerWheel, spawner, circleTexture));
+		}
+
+		// La zone visible de l'écran, utilisée pour décider du bucket de mise à jour des entités
+		SDL_Rect viewport = { 0, 0, 1280, 720 };
+		UpdateClock updateClock;
+
+		// Le champ de flux guidant les agents vers le joueur, couvrant l'écran avec des cellules de 32 pixels,
+		// avec un mur au milieu pour que les agents aient à le contourner
+		FlowField flowField(40, 23, 32.f);
+		for (unsigned int y = 3; y < 20; ++y)
+			flowField.SetObstacle(20, y, true);
+
+		// Les obstacles (en gris) ne changent presque jamais : ils sont dessinés dans un calque, qui n'est redessiné que lorsqu'un obstacle
+		// est ajouté ou retiré, et affiché d'une seule copie le reste du temps
+		SDLppRenderTarget obstacleLayer(renderer, viewport.w, viewport.h, [&](SDLppRenderer& layerRenderer)
+		{
+			layerRenderer.SetDrawColor(80, 80, 80);
+			int cellSize = static_cast<int>(flowField.GetCellSize());
+			for (unsigned int y = 0; y < flowField.GetHeight(); ++y)
+			{
+				for (unsigned int x = 0; x < flowField.GetWidth(); ++x)
+				{
+					if (flowField.IsObstacle(x, y))
+						layerRenderer.FillRect(SDL_Rect{ static_cast<int>(x) * cellSize, static_cast<int>(y) * cellSize, cellSize, cellSize });
+				}
+			}
+		});
+
+		// Rapport d'occupation mémoire des pools (F1) et compactage après une vague de disparitions (F2)
+		MemoryReporter memoryReporter;
+		memoryReporter.Register<Position>("Position");
+		memoryReporter.Register<Velocity>("Velocity");
+		memoryReporter.Register<Drawable>("Drawable");
+		memoryReporter.Register<NoGravity>("NoGravity");
+		memoryReporter.Register<FlowFieldAgent>("FlowFieldAgent");
+		memoryReporter.Register<Input>("Input");
+		memoryReporter.Register<UpdateEveryFrame>("UpdateEveryFrame");
+		memoryReporter.Register<UpdateEvery2Frames>("UpdateEvery2Frames");
+		memoryReporter.Register<UpdateEvery8Frames>("UpdateEvery8Frames");
+
+		// Mise à jour de l'état des entités dans un ordre particulier, via un scheduler qui mesure le coût de chaque système
+		// Nous visons 60 FPS, en gardant une marge pour le rendu : si la frame est sur le point de dépasser ce budget,
+		// les systèmes de faible priorité sont repoussés à une frame plus légère plutôt que de faire sauter une frame entière
+		SystemScheduler scheduler(sdl, 1.f / 60.f * 0.75f);
+
+		// Le réle de l'input system est de récupérer l'état du clavier 
+		// et de l'appliquer à l'input component des entités en ayant un (le joueur)
+		scheduler.Register("Input", SystemPriority::Critical, 0.0001f, [&](float /*elapsedTime*/) { InputSystem(sdl, registry); });
+
+		// Le Player Controller system applique les inputs à sa vélocité
+		scheduler.Register("PlayerController", SystemPriority::Critical, 0.0001f, [&](float /*elapsedTime*/) { PlayerControllerSystem(registry); });
+
+		// Le behaviour scheduler reprend les comportements dont l'attente est écoulée
+		scheduler.Register("Behaviours", SystemPriority::Critical, 0.0001f, [&](float elapsedTime) { behaviourScheduler.Update(elapsedTime); });
+
+		// Le Gravity system accroit la vitesse (vers le bas) d'une entité au fil du temps
+		scheduler.Register("Gravity", SystemPriority::Critical, 0.001f, [&](float /*elapsedTime*/) { GravitySystem(registry, updateClock); });
+
+		// Le flow field system oriente les agents vers le joueur, le champ n'étant recalculé que si celui-ci change de cellule
+		// Un agent qui garde sa direction une frame de plus ne se remarque pas : il peut être repoussé
+		scheduler.Register("FlowField", SystemPriority::Low, 0.001f, [&](float /*elapsedTime*/)
+		{
+			const auto& playerPos = registry.get<Position>(player);
+			flowField.SetGoal(playerPos.x, playerPos.y);
+
+			FlowFieldSystem(registry, flowField);
+		});
+
+		// Le velocity system répercute la vélocité sur la position
+		scheduler.Register("Velocity", SystemPriority::Critical, 0.001f, [&](float /*elapsedTime*/) { VelocitySystem(registry, updateClock); });
+
+		// L'update bucket system range les entités dans un bucket selon leur distance au joueur et à l'écran,
+		// le faire avec une frame de retard n'a pas de conséquence visible : il peut être repoussé
+		scheduler.Register("UpdateBucket", SystemPriority::Low, 0.001f, [&](float /*elapsedTime*/) { UpdateBucketSystem(registry, updateClock, player, viewport); });
+
+		// Les minuteries expirées appliquent leurs commandes en fin de mise à jour, un point de synchronisation
+		// où aucun autre système ne parcourt le registre
+		scheduler.Register("Timers", SystemPriority::Critical, 0.0001f, [&](float elapsedTime)
+		{
+			timerWheel.Advance(elapsedTime);
+			timerWheel.Flush(registry);
+		});
+
 		// SDL_GetPerformanceCounter nous renvoie un nombre qui ne fait que croitre avec le temps
 		Uint64 lastTime = sdl.GetPerformanceCounter();
 		// SDL_GetPerformanceFrequency nous renvoie l'incrément que prendra le nombre en une seconde
@@ -98,6 +209,8 @@ int main()
 			float elapsedTime = static_cast<float>(now - lastTime) / static_cast<float>(freq);
 			lastTime = now;
 
+			updateClock.Advance(elapsedTime);
+
 			SDL_Event event;
 			while (sdl.PollEvent(event))
 			{
@@ -107,6 +220,33 @@ int main()
 						running = false;
 						break;
 
+					// Le contenu des textures cibles a été perdu (avec Direct3D, lors d'un changement de résolution par exemple)
+					case SDL_RENDER_TARGETS_RESET:
+						obstacleLayer.Invalidate();
+						break;
+
+					// Touches de debug
+					case SDL_KEYDOWN:
+					{
+						if (event.key.keysym.sym == SDLK_F1)
+						{
+							MemoryReporter::Print(std::cout, memoryReporter.Report(registry));
+							std::cout << "Text cache: " << textCache.GetHitCount() << " hits, " << textCache.GetMissCount() << " misses, " << textCache.GetMemoryUsage() / 1024 << " KiB" << std::endl;
+							std::cout << "SDF font: " << hudSdfFont.GetMemoryUsage() / 1024 << " KiB" << std::endl;
+						}
+						else if (event.key.keysym.sym == SDLK_F2)
+						{
+							std::size_t freedBytes = memoryReporter.Compact(registry);
+							std::cout << "Compacted pools, " << freedBytes / 1024 << " KiB freed" << std::endl;
+							eventLog.AppendParagraph("Pools compactés, " + std::to_string(freedBytes / 1024) + " Kio libérés");
+						}
+						else if (event.key.keysym.sym == SDLK_F3)
+							hudSize = std::max(hudSize - 4, 8);
+						else if (event.key.keysym.sym == SDLK_F4)
+							hudSize = std::min(hudSize + 4, 256);
+						break;
+					}
+
 					// Lorsqu'un bouton de la souris est déclenché
 					case SDL_MOUSEBUTTONDOWN:
 					{
@@ -131,6 +271,48 @@ int main()
 							auto& velocity = registry.emplace<Velocity>(entity);
 							velocity.x = rand() % 1000 - 500;
 							velocity.y = -(rand() % 1000);
+
+							// Le cercle apparait sous la souris et donc à l'écran, il commence par être mis à jour à chaque frame
+							registry.emplace<UpdateEveryFrame>(entity);
+
+							// Et disparait au bout de dix secondes
+							timerWheel.ScheduleDespawn(entity, 10.f);
+
+							eventLog.AppendParagraph("Cercle créé en " + std::to_string(event.button.x) + ", " + std::to_string(event.button.y));
+						}
+						// Le bouton droit fait apparaitre un groupe d'agents qui poursuivent le joueur
+						else if (event.button.button == SDL_BUTTON_RIGHT)
+						{
+							for (unsigned int i = 0; i < 50; ++i)
+							{
+								entt::entity entity = registry.create();
+								auto& entityPos = registry.emplace<Position>(entity);
+								entityPos.x = event.button.x + rand() % 64 - 32;
+								entityPos.y = event.button.y + rand() % 64 - 32;
+
+								auto& entityDrawable = registry.emplace<Drawable>(entity);
+								entityDrawable.width = 16;
+								entityDrawable.height = 16;
+								entityDrawable.texture = circleTexture;
+
+								registry.emplace<Velocity>(entity);
+								registry.emplace<FlowFieldAgent>(entity, 150.f + rand() % 100);
+								registry.emplace<NoGravity>(entity);
+								registry.emplace<UpdateEveryFrame>(entity);
+							}
+
+							eventLog.AppendParagraph("50 agents créés en " + std::to_string(event.button.x) + ", " + std::to_string(event.button.y));
+						}
+						// Le bouton du milieu ajoute ou retire un obstacle (seules les cellules concernées du champ de flux sont recalculées)
+						else if (event.button.button == SDL_BUTTON_MIDDLE)
+						{
+							unsigned int cellX = static_cast<unsigned int>(event.button.x / flowField.GetCellSize());
+							unsigned int cellY = static_cast<unsigned int>(event.button.y / flowField.GetCellSize());
+							if (cellX < flowField.GetWidth() && cellY < flowField.GetHeight())
+							{
+								flowField.SetObstacle(cellX, cellY, !flowField.IsObstacle(cellX, cellY));
+								obstacleLayer.Invalidate();
+							}
 						}
 						break;
 					}
@@ -140,27 +322,45 @@ int main()
 				}
 			}
 
-			// Mise à jour de l'état des entités dans un ordre particulier
-
-			// Le réle de l'input system est de récupérer l'état du clavier 
-			// et de l'appliquer à l'input component des entités en ayant un (le joueur)
-			InputSystem(sdl, registry);
-
-			// Le Player Controller system applique les inputs à sa vélocité
-			PlayerControllerSystem(registry);
+			// Mise à jour de l'état des entités (le budget de la frame est compté depuis le début de l'itération)
+			scheduler.Run(now, elapsedTime);
 
-			// Le Gravity system accroit la vitesse (vers le bas) d'une entité au fil du temps
-			GravitySystem(registry, elapsedTime);
+			// Les images décodées depuis la frame précédente deviennent des textures, sans y consacrer plus de 2ms
+			renderer.UploadPendingTextures(0.002f);
 
-			// Le velocity system répercute la vélocité sur la position
-			VelocitySystem(registry, elapsedTime);
+			// Le joueur obtient une façon de l'afficher dés que sa texture est prête, texture confiée au cache
+			// pour que les chargements suivants de la même image la réutilisent
+			if (playerTexture.valid() && playerTexture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			{
+				auto& entityDrawable = registry.emplace<Drawable>(player);
+				entityDrawable.width = 640.f / 5.f;
+				entityDrawable.height = 427.f / 5.f;
+				entityDrawable.texture = textureCache.Insert("resources/player.png", playerTexture.get());
+			}
 
 			// Rendu de la scéne (on vide l'écran, on affiche les entités avec un systéme et on le présente)
 			renderer.SetDrawColor(0, 0, 0);
 			renderer.Clear();
 
+			// Les obstacles du champ de flux
+			renderer.DrawLayer(obstacleLayer);
+
 			// Le render system affiche ensuite chaque entité disposant d'une position et d'un Drawable
 			RenderSystem(registry, renderer);
+
+			// Et enfin l'interface
+			std::string hudText = "Entities: " + std::to_string(registry.view<Position>().size()) + "\nFPS: " + std::to_string(elapsedTime > 0.f ? static_cast<int>(1.f / elapsedTime) : 0);
+			renderer.DrawText(hudSdfFont.GetAtlas(hudSize), hudText, 10, 10);
+
+			std::shared_ptr<SDLppTexture> helpTexture = textCache.Render(hudFont, "Clic gauche : cercle, clic droit : agents, clic milieu : obstacle");
+			SDL_Rect helpRect = helpTexture->GetRect();
+			helpRect.x = 10;
+			helpRect.y = viewport.h - helpRect.h - 10;
+			renderer.Copy(*helpTexture, helpRect);
+
+			// Le bas du journal est aligné au-dessus de l'aide, les lignes sortant de l'écran ne sont pas envoyées
+			renderer.DrawText(eventLog, viewport.w - eventLog.GetMaxWidth() - 10, helpRect.y - 10 - eventLog.GetHeight());
+
 			renderer.Present();
 		}
 
@@ -173,84 +373,38 @@ int main()
 	}
 }
 
-void PlayerControllerSystem(entt::registry& registry)
+Behaviour SpawnerBehaviour(entt::registry& registry, TimerWheel& timerWheel, entt::entity entity, std::shared_ptr<SDLppTexture> circleTexture)
 {
-	auto view = registry.view<Input, Velocity>();
-	view.each([](const Input& input, Velocity& velocity)
+	// Écrit comme une simple boucle, ce comportement serait une machine à états sans les coroutines :
+	// attendre deux secondes, foncer sur le côté, puis lâcher un cercle, en alternant gauche et droite
+	float dashDirection = -1.f;
+	for (;;)
 	{
-		velocity.x = 0.f;
-		velocity.y = 0.f;
+		co_await WaitFor(2.f);
 
-		if (input.up)
-			velocity.y += -500.f;
+		registry.get<Velocity>(entity).x = dashDirection * 800.f;
+		co_await WaitFor(0.25f);
+		registry.get<Velocity>(entity).x = 0.f;
 
-		if (input.down)
-			velocity.y += 500.f;
+		const auto& spawnerPos = registry.get<Position>(entity);
 
-		if (input.left)
-			velocity.x += -500.f;
+		entt::entity circle = registry.create();
+		auto& circlePos = registry.emplace<Position>(circle);
+		circlePos.x = spawnerPos.x;
+		circlePos.y = spawnerPos.y;
 
-		if (input.right)
-			velocity.x += 500.f;
-	});
-}
+		auto& circleDrawable = registry.emplace<Drawable>(circle);
+		circleDrawable.width = 48;
+		circleDrawable.height = 48;
+		circleDrawable.texture = circleTexture;
 
-void InputSystem(const SDLpp& sdl, entt::registry& registry)
-{
-	const Uint8* state = sdl.GetKeyboardState();
-
-	auto view = registry.view<Input>();
-	for (entt::entity entity : view)
-	{
-		auto& input = view.get<Input>(entity);
-		input.down = state[SDL_SCANCODE_DOWN];
-		input.left = state[SDL_SCANCODE_LEFT];
-		input.right = state[SDL_SCANCODE_RIGHT];
-		input.up = state[SDL_SCANCODE_UP];
-	}
-}
+		registry.emplace<Velocity>(circle);
+		registry.emplace<UpdateEveryFrame>(circle);
 
-void GravitySystem(entt::registry& registry, float elapsedTime)
-{
-	const float GravityConstant = 981.f;
-
-	// Nous ne voulons que les entités ayant une vélocité (et n'ayant pas de composant NoGravity)
-	auto view = registry.view<Velocity>(entt::exclude<NoGravity>);
-	for (entt::entity entity : view)
-	{
-		auto& entityVel = view.get<Velocity>(entity);
-
-		entityVel.y += GravityConstant * elapsedTime;
-	}
-}
-
-void RenderSystem(entt::registry& registry, SDLppRenderer& renderer)
-{
-	auto view = registry.view<Position, Drawable>();
-	for (entt::entity entity : view)
-	{
-		auto& entityPos = view.get<Position>(entity);
-		auto& entityDrawable = view.get<Drawable>(entity);
-
-		SDL_Rect rect;
-		rect.x = static_cast<int>(entityPos.x);
-		rect.y = static_cast<int>(entityPos.y);
-		rect.w = entityDrawable.width;
-		rect.h = entityDrawable.height;
-
-		renderer.Copy(*entityDrawable.texture, rect);
-	}
-}
-
-void VelocitySystem(entt::registry& registry, float elapsedTime)
-{
-	auto view = registry.view<Position, Velocity>();
-	for (entt::entity entity : view)
-	{
-		auto& entityPos = view.get<Position>(entity);
-		auto& entityVel = view.get<Velocity>(entity);
+		// Le cercle flotte une seconde avant de tomber
+		registry.emplace<NoGravity>(circle);
+		timerWheel.ScheduleRemove<NoGravity>(circle, 1.f);
 
-		entityPos.x += entityVel.x * elapsedTime;
-		entityPos.y += entityVel.y * elapsedTime;
+		dashDirection = -dashDirection;
 	}
 }
@@ -1,5 +1,8 @@
+#include "ecs/SharedComponentMirror.hpp"
 #include <entt/entt.hpp>
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 struct Position
 {
@@ -13,6 +16,12 @@ struct Velocity
 	float y = 0.f;
 };
 
+// Un std::string ne peut pas être recopié tel quel en mémoire partagée : le nom est stocké dans un tableau de taille fixe
+struct Name
+{
+	char value[16];
+};
+
 int main()
 {
 	entt::registry registry;
@@ -25,15 +34,24 @@ int main()
 		auto& velocity = registry.emplace<Velocity>(maSuperEntity);
 		velocity.x = -10.f;
 
-		registry.emplace<std::string>(maSuperEntity, "Alexis");
+		registry.emplace<Name>(maSuperEntity, Name{ "Alexis" });
 	}
 
 	entt::entity maSuperEntity2 = registry.create();
 	{
-		registry.emplace<std::string>(maSuperEntity2, "Matilde");
+		registry.emplace<Name>(maSuperEntity2, Name{ "Matilde" });
 		registry.emplace<Position>(maSuperEntity2);
 	}
 
+	// Plutôt que d'afficher chaque entité à chaque tick, les noms, positions et vélocités sont recopiés dans une mémoire partagée
+	// qu'un outil externe (Exemple9) peut observer sans ralentir la simulation
+	SharedComponentMirror mirror("exemple3", 1024);
+	mirror.Register<Name>("Name");
+	mirror.Register<Position>("Position");
+	mirror.Register<Velocity>("Velocity");
+
+	std::cout << "Publishing to shared memory \"exemple3\", run Exemple9 to inspect" << std::endl;
+
 	for (int i = 0; i < 100; ++i)
 	{
 		auto velocityView = registry.view<Position, Velocity>();
@@ -46,13 +64,9 @@ int main()
 			pos.y += vel.y;
 		}
 
-		auto listView = registry.view<Position, std::string>();
-		for (entt::entity entity : listView)
-		{
-			auto& pos = listView.get<Position>(entity);
-			auto& name = listView.get<std::string>(entity);
+		mirror.Publish(registry);
 
-			std::cout << name << ": " << pos.x << ", " << pos.y << std::endl;
-		}
+		// On ralentit la simulation pour laisser le temps de l'observer
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
 	}
 }
@@ -0,0 +1,178 @@
+// Simulation en lot de plusieurs mondes indépendants, sans fenêtre ni renderer
+// Chaque monde est un entt::registry à part entière, construit à partir d'un même setup puis paramétré
+// (constante de gravité, motif d'apparition), et les mondes sont simulés en parallèle à raison d'un monde par cœur.
+
+#include "ecs/Components.hpp"
+#include "ecs/Systems.hpp"
+#include "ecs/ThreadPool.hpp"
+#include "ecs/UpdateClock.hpp"
+#include <entt/entt.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+enum class SpawnPattern
+{
+	Burst,
+	Grid
+};
+
+struct WorldParameters
+{
+	SpawnPattern spawnPattern;
+	float gravityConstant;
+	unsigned int entityCount;
+	unsigned int seed;
+};
+
+struct WorldResult
+{
+	float averageX = 0.f;
+	float averageY = 0.f;
+	float maxSpeed = 0.f;
+	std::size_t entityCount = 0;
+};
+
+struct World
+{
+	entt::registry registry;
+	UpdateClock clock;
+	WorldParameters parameters;
+	WorldResult result;
+};
+
+void SetupWorld(World& world);
+void StepWorld(World& world, float elapsedTime);
+void ComputeResult(World& world);
+
+int main()
+{
+	const unsigned int TickCount = 600;
+	const float TickDuration = 1.f / 60.f;
+
+	// On fait varier la constante de gravité et le motif d'apparition d'un monde à l'autre
+	std::vector<World> worlds(16);
+	for (std::size_t i = 0; i < worlds.size(); ++i)
+	{
+		WorldParameters& parameters = worlds[i].parameters;
+		parameters.entityCount = 50'000;
+		parameters.gravityConstant = 981.f * static_cast<float>(i / 2) / 4.f;
+		parameters.seed = static_cast<unsigned int>(i);
+		parameters.spawnPattern = (i % 2 == 0) ? SpawnPattern::Burst : SpawnPattern::Grid;
+	}
+
+	ThreadPool threadPool;
+	std::cout << "Simulating " << worlds.size() << " worlds on " << threadPool.GetThreadCount() << " threads" << std::endl;
+
+	auto start = std::chrono::steady_clock::now();
+
+	// Un monde par tranche : chaque thread prend un monde, le simule jusqu'au bout puis passe au suivant.
+	// Les mondes ne partagent rien, il n'y a donc aucune synchronisation à faire pendant la simulation
+	threadPool.ParallelFor(worlds.size(), 1, [&](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			World& world = worlds[i];
+			SetupWorld(world);
+
+			for (unsigned int tick = 0; tick < TickCount; ++tick)
+				StepWorld(world, TickDuration);
+
+			ComputeResult(world);
+		}
+	});
+
+	auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+	// Agrégation des résultats, une fois tous les mondes terminés
+	for (const World& world : worlds)
+	{
+		const WorldParameters& parameters = world.parameters;
+		const WorldResult& result = world.result;
+
+		std::cout << ((parameters.spawnPattern == SpawnPattern::Burst) ? "burst" : "grid ");
+		std::cout << " gravity=" << parameters.gravityConstant;
+		std::cout << " entities=" << result.entityCount;
+		std::cout << " average=(" << result.averageX << ", " << result.averageY << ")";
+		std::cout << " maxSpeed=" << result.maxSpeed << "\n";
+	}
+
+	std::cout << "Done in " << duration.count() << "ms" << std::endl;
+
+	return 0;
+}
+
+void SetupWorld(World& world)
+{
+	const WorldParameters& parameters = world.parameters;
+	entt::registry& registry = world.registry;
+
+	std::mt19937 randomEngine(parameters.seed);
+	std::uniform_real_distribution<float> velocityDistribution(-500.f, 500.f);
+
+	unsigned int gridSize = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<float>(parameters.entityCount))));
+
+	for (unsigned int i = 0; i < parameters.entityCount; ++i)
+	{
+		entt::entity entity = registry.create();
+
+		auto& entityPos = registry.emplace<Position>(entity);
+		auto& entityVel = registry.emplace<Velocity>(entity);
+
+		switch (parameters.spawnPattern)
+		{
+			// Toutes les entités partent du même point dans des directions aléatoires
+			case SpawnPattern::Burst:
+				entityPos.x = 640.f;
+				entityPos.y = 360.f;
+				entityVel.x = velocityDistribution(randomEngine);
+				entityVel.y = velocityDistribution(randomEngine);
+				break;
+
+			// Les entités sont réparties sur une grille, immobiles
+			case SpawnPattern::Grid:
+				entityPos.x = static_cast<float>(i % gridSize) * 10.f;
+				entityPos.y = static_cast<float>(i / gridSize) * 10.f;
+				break;
+		}
+
+		// Sans joueur ni écran, toutes les entités sont mises à jour à chaque tick
+		registry.emplace<UpdateEveryFrame>(entity);
+	}
+}
+
+void StepWorld(World& world, float elapsedTime)
+{
+	// On réutilise les systèmes de l'exemple 2, sauf ceux liés aux entrées et au rendu
+	world.clock.Advance(elapsedTime);
+
+	GravitySystem(world.registry, world.clock, world.parameters.gravityConstant);
+	VelocitySystem(world.registry, world.clock);
+}
+
+void ComputeResult(World& world)
+{
+	WorldResult& result = world.result;
+
+	auto view = world.registry.view<Position, Velocity>();
+	for (entt::entity entity : view)
+	{
+		auto& entityPos = view.get<Position>(entity);
+		auto& entityVel = view.get<Velocity>(entity);
+
+		result.averageX += entityPos.x;
+		result.averageY += entityPos.y;
+		result.maxSpeed = std::max(result.maxSpeed, std::hypot(entityVel.x, entityVel.y));
+		result.entityCount++;
+	}
+
+	if (result.entityCount > 0)
+	{
+		result.averageX /= static_cast<float>(result.entityCount);
+		result.averageY /= static_cast<float>(result.entityCount);
+	}
+}
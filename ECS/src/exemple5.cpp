@@ -0,0 +1,102 @@
+// Simulation spéculative : on clone le monde, on simule quelques centaines de ticks sur la copie pour voir
+// ce qu'il se passerait (lookahead d'une IA, outil "what-if"), puis on jette la copie sans toucher au monde original.
+
+#include "ecs/Components.hpp"
+#include "ecs/Systems.hpp"
+#include "ecs/UpdateClock.hpp"
+#include "ecs/WorldCloner.hpp"
+#include <entt/entt.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <utility>
+
+int main()
+{
+	const unsigned int EntityCount = 100'000;
+	const unsigned int CloneCount = 100;
+	const unsigned int LookaheadTicks = 300;
+	const float TickDuration = 1.f / 60.f;
+	const double TargetCloneTime = 1000.0; //< Objectif : cloner le monde en moins d'une milliseconde
+
+	entt::registry world;
+
+	// Sans renderer on ne peut pas charger de texture, mais une texture (nulle ici) reste partagée
+	// par toutes les entités : le clonage ne fait que copier le std::shared_ptr
+	std::shared_ptr<SDLppTexture> circleTexture;
+
+	std::mt19937 randomEngine(42);
+	std::uniform_real_distribution<float> positionDistribution(0.f, 1280.f);
+	std::uniform_real_distribution<float> velocityDistribution(-500.f, 500.f);
+
+	for (unsigned int i = 0; i < EntityCount; ++i)
+	{
+		entt::entity entity = world.create();
+
+		auto& entityPos = world.emplace<Position>(entity);
+		entityPos.x = positionDistribution(randomEngine);
+		entityPos.y = positionDistribution(randomEngine);
+
+		auto& entityVel = world.emplace<Velocity>(entity);
+		entityVel.x = velocityDistribution(randomEngine);
+		entityVel.y = velocityDistribution(randomEngine);
+
+		auto& entityDrawable = world.emplace<Drawable>(entity);
+		entityDrawable.width = 32;
+		entityDrawable.height = 32;
+		entityDrawable.texture = circleTexture;
+
+		world.emplace<UpdateEveryFrame>(entity);
+	}
+
+	// On indique au cloner quels composants copier
+	WorldCloner cloner;
+	cloner.Register<Position>();
+	cloner.Register<Velocity>();
+	cloner.Register<Input>();
+	cloner.Register<Drawable>();
+	cloner.Register<NoGravity>();
+	cloner.Register<UpdateEveryFrame>();
+	cloner.Register<UpdateEvery2Frames>();
+	cloner.Register<UpdateEvery8Frames>();
+
+	// Ainsi que les phases des buckets, chacune étant son propre composant
+	[&]<unsigned int... Phases>(std::integer_sequence<unsigned int, Phases...>) { (cloner.Register<UpdatePhase<UpdateEvery2Frames, Phases>>(), ...); }(std::make_integer_sequence<unsigned int, UpdateEvery2Frames::Period>{});
+	[&]<unsigned int... Phases>(std::integer_sequence<unsigned int, Phases...>) { (cloner.Register<UpdatePhase<UpdateEvery8Frames, Phases>>(), ...); }(std::make_integer_sequence<unsigned int, UpdateEvery8Frames::Period>{});
+
+	// Le registre de simulation est préalloué une fois pour toutes, puis réutilisé par chaque clonage
+	entt::registry lookahead;
+	cloner.Reserve(lookahead, EntityCount);
+
+	std::chrono::steady_clock::duration cloneDuration{};
+	for (unsigned int i = 0; i < CloneCount; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		cloner.Clone(world, lookahead);
+		cloneDuration += std::chrono::steady_clock::now() - start;
+	}
+
+	double averageCloneTime = std::chrono::duration<double, std::micro>(cloneDuration).count() / CloneCount;
+	std::cout << "Average clone time for " << EntityCount << " entities: " << averageCloneTime << "us ";
+	std::cout << "(target: < " << TargetCloneTime << "us, " << ((averageCloneTime < TargetCloneTime) ? "met" : "missed") << ")" << std::endl;
+
+	// On simule la copie quelques secondes dans le futur
+	UpdateClock clock;
+	for (unsigned int tick = 0; tick < LookaheadTicks; ++tick)
+	{
+		clock.Advance(TickDuration);
+		GravitySystem(lookahead, clock);
+		VelocitySystem(lookahead, clock);
+	}
+
+	// Le monde original n'a pas bougé, seule la copie a avancé
+	entt::entity firstEntity = *world.view<Position>().begin();
+	const auto& currentPos = world.get<Position>(firstEntity);
+	const auto& futurePos = lookahead.get<Position>(firstEntity);
+
+	std::cout << "Entity position now: (" << currentPos.x << ", " << currentPos.y << ")" << std::endl;
+	std::cout << "Entity position in " << LookaheadTicks << " ticks: (" << futurePos.x << ", " << futurePos.y << ")" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,75 @@
+// Gravité mutuelle entre un grand nombre de corps (algorithme de Barnes-Hut), sans fenêtre ni renderer
+// On simule un disque de corps en rotation autour d'une masse centrale et on mesure le temps passé par tick.
+
+#include "ecs/Components.hpp"
+#include "ecs/NBodyGravitySystem.hpp"
+#include "ecs/Systems.hpp"
+#include "ecs/ThreadPool.hpp"
+#include "ecs/UpdateClock.hpp"
+#include <entt/entt.hpp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+int main()
+{
+	const unsigned int BodyCount = 200'000;
+	const unsigned int TickCount = 60;
+	const float TickDuration = 1.f / 60.f;
+	const float GravitationalConstant = 1.f;
+	const float CentralMass = 1'000'000.f;
+
+	entt::registry registry;
+
+	// Une masse centrale immobile (sans Velocity, elle attire sans être attirée)
+	entt::entity center = registry.create();
+	registry.emplace<Position>(center);
+	registry.emplace<Mass>(center, CentralMass);
+
+	std::mt19937 randomEngine(42);
+	std::uniform_real_distribution<float> angleDistribution(0.f, 2.f * 3.14159265f);
+	std::uniform_real_distribution<float> radiusDistribution(100.f, 5000.f);
+
+	for (unsigned int i = 0; i < BodyCount; ++i)
+	{
+		float angle = angleDistribution(randomEngine);
+		float radius = radiusDistribution(randomEngine);
+
+		entt::entity entity = registry.create();
+
+		auto& entityPos = registry.emplace<Position>(entity);
+		entityPos.x = std::cos(angle) * radius;
+		entityPos.y = std::sin(angle) * radius;
+
+		// Vitesse orbitale circulaire autour de la masse centrale
+		float orbitalSpeed = std::sqrt(GravitationalConstant * CentralMass / radius);
+		auto& entityVel = registry.emplace<Velocity>(entity);
+		entityVel.x = -std::sin(angle) * orbitalSpeed;
+		entityVel.y = std::cos(angle) * orbitalSpeed;
+
+		registry.emplace<Mass>(entity, 1.f);
+		registry.emplace<UpdateEveryFrame>(entity);
+	}
+
+	ThreadPool threadPool;
+	NBodyGravitySystem nbodyGravitySystem(threadPool, GravitationalConstant, 0.5f);
+	UpdateClock clock;
+
+	std::cout << "Simulating " << BodyCount << " bodies on " << threadPool.GetThreadCount() << " threads" << std::endl;
+
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int tick = 0; tick < TickCount; ++tick)
+	{
+		clock.Advance(TickDuration);
+
+		// Le NBodyGravity system remplace ici le Gravity system (qui n'applique qu'une gravité constante vers le bas)
+		nbodyGravitySystem.Update(registry, TickDuration);
+		VelocitySystem(registry, clock);
+	}
+	auto duration = std::chrono::steady_clock::now() - start;
+
+	std::cout << "Average tick time: " << std::chrono::duration<double, std::milli>(duration).count() / TickCount << "ms" << std::endl;
+
+	return 0;
+}
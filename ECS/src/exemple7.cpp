@@ -0,0 +1,61 @@
+// Comportement de nuée (boids) sur une foule de 100 000 agents, sans fenêtre ni renderer
+// On mesure le temps passé par tick par le Boids system (grille de voisinage + calcul des forces).
+
+#include "ecs/BoidsSystem.hpp"
+#include "ecs/Components.hpp"
+#include "ecs/Systems.hpp"
+#include "ecs/ThreadPool.hpp"
+#include "ecs/UpdateClock.hpp"
+#include <entt/entt.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+int main()
+{
+	const unsigned int BoidCount = 100'000;
+	const unsigned int TickCount = 120;
+	const float TickDuration = 1.f / 60.f;
+
+	entt::registry registry;
+
+	std::mt19937 randomEngine(42);
+	std::uniform_real_distribution<float> positionDistribution(0.f, 5000.f);
+	std::uniform_real_distribution<float> velocityDistribution(-100.f, 100.f);
+
+	for (unsigned int i = 0; i < BoidCount; ++i)
+	{
+		entt::entity entity = registry.create();
+
+		auto& entityPos = registry.emplace<Position>(entity);
+		entityPos.x = positionDistribution(randomEngine);
+		entityPos.y = positionDistribution(randomEngine);
+
+		auto& entityVel = registry.emplace<Velocity>(entity);
+		entityVel.x = velocityDistribution(randomEngine);
+		entityVel.y = velocityDistribution(randomEngine);
+
+		registry.emplace<Boid>(entity);
+		registry.emplace<UpdateEveryFrame>(entity);
+	}
+
+	ThreadPool threadPool;
+	BoidsSystem boidsSystem(threadPool);
+	UpdateClock clock;
+
+	std::cout << "Simulating " << BoidCount << " boids on " << threadPool.GetThreadCount() << " threads" << std::endl;
+
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int tick = 0; tick < TickCount; ++tick)
+	{
+		clock.Advance(TickDuration);
+
+		boidsSystem.Update(registry, TickDuration);
+		VelocitySystem(registry, clock);
+	}
+	auto duration = std::chrono::steady_clock::now() - start;
+
+	std::cout << "Average tick time: " << std::chrono::duration<double, std::milli>(duration).count() / TickCount << "ms" << std::endl;
+
+	return 0;
+}
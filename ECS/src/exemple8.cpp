@@ -0,0 +1,84 @@
+// Croissance des pools de composants sur un monde de plusieurs millions d'entités, sans fenêtre ni renderer
+// On fait apparaitre les entités par vagues (une vague par frame) et on mesure la pire frame : avec l'allocateur par défaut,
+// chaque fois qu'un pool dépasse sa capacité il est réalloué et recopié, ce qui produit un pic.
+// Avec une VirtualArena, la capacité finale est réservée d'avance sans engager de mémoire physique et le pool ne se réalloue jamais.
+
+#include "ecs/ArenaAllocator.hpp"
+#include "ecs/Components.hpp"
+#include "ecs/VirtualArena.hpp"
+#include <entt/entt.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+const unsigned int EntityCount = 4'000'000;
+const unsigned int WaveSize = 20'000;
+const unsigned int IterationCount = 20;
+
+template<typename Registry>
+void RunBenchmark(const char* name, Registry& registry)
+{
+	std::vector<entt::entity> wave(WaveSize);
+
+	double worstWaveTime = 0.0;
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int spawned = 0; spawned < EntityCount; spawned += WaveSize)
+	{
+		auto waveStart = std::chrono::steady_clock::now();
+
+		registry.create(wave.begin(), wave.end());
+		for (unsigned int i = 0; i < WaveSize; ++i)
+		{
+			auto& entityPos = registry.template emplace<Position>(wave[i]);
+			entityPos.x = static_cast<float>(spawned + i);
+
+			auto& entityVel = registry.template emplace<Velocity>(wave[i]);
+			entityVel.x = 1.f;
+		}
+
+		worstWaveTime = std::max(worstWaveTime, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - waveStart).count());
+	}
+	double spawnTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	// Le parcours des pools bénéficie des pages énormes (moins de défauts de TLB)
+	start = std::chrono::steady_clock::now();
+	for (unsigned int iteration = 0; iteration < IterationCount; ++iteration)
+	{
+		registry.template view<Position, Velocity>().each([](Position& pos, const Velocity& vel)
+		{
+			pos.x += vel.x * 0.016f;
+			pos.y += vel.y * 0.016f;
+		});
+	}
+	double iterationTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / IterationCount;
+
+	std::cout << name << ":\n";
+	std::cout << "  spawn: " << spawnTime << "ms total, worst wave " << worstWaveTime << "ms\n";
+	std::cout << "  iteration: " << iterationTime << "ms per pass" << std::endl;
+}
+
+int main()
+{
+	std::cout << "Spawning " << EntityCount << " entities in waves of " << WaveSize << std::endl;
+
+	{
+		entt::registry registry;
+		RunBenchmark("std::allocator", registry);
+	}
+
+	{
+		// 16 Go d'espace d'adressage, seules les pages effectivement touchées consomment de la mémoire
+		VirtualArena arena(16ull * 1024 * 1024 * 1024, true);
+
+		ArenaRegistry registry{ ArenaAllocator<entt::entity>(arena) };
+		registry.storage<Position>().reserve(EntityCount);
+		registry.storage<Velocity>().reserve(EntityCount);
+
+		RunBenchmark(arena.UsesHugePages() ? "VirtualArena (huge pages)" : "VirtualArena", registry);
+
+		std::cout << "  arena: " << arena.GetUsedSize() / (1024 * 1024) << "MB in use" << std::endl;
+	}
+
+	return 0;
+}
\ No newline at end of file
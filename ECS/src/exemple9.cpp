@@ -0,0 +1,85 @@
+// Inspecteur externe : observe depuis un autre processus les composants publiés par Exemple3 en mémoire partagée
+// Le jeu n'est jamais ralenti ni bloqué par l'inspecteur, qui se contente de relire la dernière frame cohérente.
+
+#include "ecs/Components.hpp"
+#include "ecs/SharedComponentMirror.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <thread>
+
+// Même disposition que le composant Name d'Exemple3
+struct Name
+{
+	char value[16];
+};
+
+// Nom de l'entité s'il est publié, son identifiant sinon
+std::string GetEntityLabel(const SharedMirrorSnapshot::Pool* names, entt::entity entity)
+{
+	if (names)
+	{
+		auto it = std::find(names->entities.begin(), names->entities.end(), entity);
+		if (it != names->entities.end())
+		{
+			// Le nom vient d'un autre processus : on ne compte pas sur la présence du zéro final
+			const Name& name = names->Get<Name>(static_cast<std::size_t>(it - names->entities.begin()));
+			return std::string(std::begin(name.value), std::find(std::begin(name.value), std::end(name.value), '\0'));
+		}
+	}
+
+	return "Entity #" + std::to_string(entt::to_integral(entity));
+}
+
+int main()
+{
+	try
+	{
+		SharedComponentMirrorReader reader("exemple3");
+		SharedMirrorSnapshot snapshot;
+
+		// Aucune frame lue au départ : la frame 0 est la première que publie le jeu
+		std::optional<std::uint64_t> lastFrame;
+		unsigned int idleCount = 0;
+
+		// On s'arrête quand le jeu ne publie plus de nouvelle frame depuis une seconde
+		while (idleCount < 10)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+			if (!reader.ReadSnapshot(snapshot) || snapshot.frame == lastFrame)
+			{
+				idleCount++;
+				continue;
+			}
+
+			idleCount = 0;
+			lastFrame = snapshot.frame;
+
+			std::cout << "Frame " << snapshot.frame << ":\n";
+
+			const SharedMirrorSnapshot::Pool* names = snapshot.FindPool("Name");
+			if (const SharedMirrorSnapshot::Pool* positions = snapshot.FindPool("Position"))
+			{
+				for (std::size_t i = 0; i < positions->entities.size(); ++i)
+				{
+					const Position& pos = positions->Get<Position>(i);
+					std::cout << "  " << GetEntityLabel(names, positions->entities[i]) << " position: (" << pos.x << ", " << pos.y << ")\n";
+				}
+			}
+
+			std::cout << std::flush;
+		}
+
+		return 0;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "SDLppBlitKernels.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SDLPP_BLIT_X86
+#include <immintrin.h>
+
+// GCC et Clang n'autorisent les instructions SSE2/AVX2 que dans les fonctions qui le déclarent (le reste du programme
+// restant compilable pour n'importe quel processeur x86) ; MSVC les autorise partout
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SDLPP_TARGET(instructionSet)
+#else
+#define SDLPP_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#endif
+#endif
+
+namespace
+{
+	// x / 255 arrondi au plus proche, exact pour x <= 255 * 255 (le même calcul est fait par les versions SIMD)
+	Uint32 Div255(Uint32 x)
+	{
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	void BlendStraightScalar(Uint32* dst, const Uint32* src, std::size_t pixelCount)
+	{
+		for (std::size_t i = 0; i < pixelCount; ++i)
+		{
+			Uint32 source = src[i];
+			Uint32 alpha = source >> 24;
+			if (alpha == 0)
+				continue;
+
+			if (alpha == 255)
+			{
+				dst[i] = source;
+				continue;
+			}
+
+			Uint32 destination = dst[i];
+			Uint32 inverseAlpha = 255 - alpha;
+
+			// L'alpha de la source est traité comme une composante valant 255
+			Uint32 result = Div255(255 * alpha + (destination >> 24) * inverseAlpha) << 24;
+			for (int shift = 0; shift < 24; shift += 8)
+				result |= Div255(((source >> shift) & 0xFF) * alpha + ((destination >> shift) & 0xFF) * inverseAlpha) << shift;
+
+			dst[i] = result;
+		}
+	}
+
+	Uint32 BlendPremultipliedPixel(Uint32 source, Uint32 destination)
+	{
+		Uint32 inverseAlpha = 255 - (source >> 24);
+
+		Uint32 result = 0;
+		for (int shift = 0; shift < 32; shift += 8)
+		{
+			Uint32 component = ((source >> shift) & 0xFF) + Div255(((destination >> shift) & 0xFF) * inverseAlpha);
+			result |= ((component > 255) ? 255 : component) << shift;
+		}
+
+		return result;
+	}
+
+	void BlendPremultipliedScalar(Uint32* dst, const Uint32* src, std::size_t pixelCount)
+	{
+		for (std::size_t i = 0; i < pixelCount; ++i)
+		{
+			Uint32 source = src[i];
+			if (source == 0)
+				continue;
+
+			if ((source >> 24) == 255)
+				dst[i] = source;
+			else
+				dst[i] = BlendPremultipliedPixel(source, dst[i]);
+		}
+	}
+
+	void FillPremultipliedScalar(Uint32* dst, Uint32 color, std::size_t pixelCount)
+	{
+		if (color == 0)
+			return;
+
+		for (std::size_t i = 0; i < pixelCount; ++i)
+			dst[i] = ((color >> 24) == 255) ? color : BlendPremultipliedPixel(color, dst[i]);
+	}
+
+#ifdef SDLPP_BLIT_X86
+	// Les pixels sont traités quatre par quatre : chaque composante est étendue sur 16 bits (deux pixels par registre)
+	// pour que les produits (au plus 255 * 255) tiennent sans débordement
+
+	SDLPP_TARGET("sse2")
+	__m128i Div255SSE2(__m128i x)
+	{
+		x = _mm_add_epi16(x, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	}
+
+	SDLPP_TARGET("sse2")
+	void BlendStraightSSE2(Uint32* dst, const Uint32* src, std::size_t pixelCount)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+		const __m128i max = _mm_set1_epi16(255);
+
+		std::size_t i = 0;
+		for (; i + 4 <= pixelCount; i += 4)
+		{
+			__m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			__m128i alpha = _mm_srli_epi32(source, 24);
+
+			// Groupes entièrement transparents ou opaques (l'essentiel d'un sprite) : rien à calculer
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xFFFF)
+				continue;
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, _mm_set1_epi32(255))) == 0xFFFF)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), source);
+				continue;
+			}
+
+			__m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+
+			// Alpha de chaque pixel répété sur ses quatre composantes
+			__m128i alpha32 = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+			__m128i alphaLo = _mm_unpacklo_epi32(alpha32, alpha32);
+			__m128i alphaHi = _mm_unpackhi_epi32(alpha32, alpha32);
+
+			source = _mm_or_si128(source, alphaMask);
+			__m128i sourceLo = _mm_unpacklo_epi8(source, zero);
+			__m128i sourceHi = _mm_unpackhi_epi8(source, zero);
+			__m128i destinationLo = _mm_unpacklo_epi8(destination, zero);
+			__m128i destinationHi = _mm_unpackhi_epi8(destination, zero);
+
+			__m128i resultLo = Div255SSE2(_mm_add_epi16(_mm_mullo_epi16(sourceLo, alphaLo), _mm_mullo_epi16(destinationLo, _mm_sub_epi16(max, alphaLo))));
+			__m128i resultHi = Div255SSE2(_mm_add_epi16(_mm_mullo_epi16(sourceHi, alphaHi), _mm_mullo_epi16(destinationHi, _mm_sub_epi16(max, alphaHi))));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(resultLo, resultHi));
+		}
+
+		BlendStraightScalar(dst + i, src + i, pixelCount - i);
+	}
+
+	SDLPP_TARGET("sse2")
+	__m128i BlendPremultipliedSSE2(__m128i source, __m128i destination)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i max = _mm_set1_epi16(255);
+
+		__m128i alpha = _mm_srli_epi32(source, 24);
+		__m128i alpha32 = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+		__m128i inverseAlphaLo = _mm_sub_epi16(max, _mm_unpacklo_epi32(alpha32, alpha32));
+		__m128i inverseAlphaHi = _mm_sub_epi16(max, _mm_unpackhi_epi32(alpha32, alpha32));
+
+		__m128i resultLo = _mm_add_epi16(_mm_unpacklo_epi8(source, zero), Div255SSE2(_mm_mullo_epi16(_mm_unpacklo_epi8(destination, zero), inverseAlphaLo)));
+		__m128i resultHi = _mm_add_epi16(_mm_unpackhi_epi8(source, zero), Div255SSE2(_mm_mullo_epi16(_mm_unpackhi_epi8(destination, zero), inverseAlphaHi)));
+
+		// La saturation de packus borne les composantes à 255, comme la version scalaire
+		return _mm_packus_epi16(resultLo, resultHi);
+	}
+
+	SDLPP_TARGET("sse2")
+	void BlendPremultipliedSSE2(Uint32* dst, const Uint32* src, std::size_t pixelCount)
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		std::size_t i = 0;
+		for (; i + 4 <= pixelCount; i += 4)
+		{
+			__m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(source, zero)) == 0xFFFF)
+				continue;
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(source, 24), _mm_set1_epi32(255))) == 0xFFFF)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), source);
+				continue;
+			}
+
+			__m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), BlendPremultipliedSSE2(source, destination));
+		}
+
+		BlendPremultipliedScalar(dst + i, src + i, pixelCount - i);
+	}
+
+	SDLPP_TARGET("sse2")
+	void FillPremultipliedSSE2(Uint32* dst, Uint32 color, std::size_t pixelCount)
+	{
+		if (color == 0)
+			return;
+
+		__m128i source = _mm_set1_epi32(static_cast<int>(color));
+		bool opaque = (color >> 24) == 255;
+
+		std::size_t i = 0;
+		for (; i + 4 <= pixelCount; i += 4)
+		{
+			__m128i* pixels = reinterpret_cast<__m128i*>(dst + i);
+			_mm_storeu_si128(pixels, (opaque) ? source : BlendPremultipliedSSE2(source, _mm_loadu_si128(pixels)));
+		}
+
+		FillPremultipliedScalar(dst + i, color, pixelCount - i);
+	}
+
+	// Même principe que SSE2 avec huit pixels par itération : unpack et packus opèrent sur chaque moitié de 128 bits
+	// indépendamment, l'ordre des pixels est donc préservé
+
+	SDLPP_TARGET("avx2")
+	__m256i Div255AVX2(__m256i x)
+	{
+		x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+		return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+	}
+
+	SDLPP_TARGET("avx2")
+	void BlendStraightAVX2(Uint32* dst, const Uint32* src, std::size_t pixelCount)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+		const __m256i max = _mm256_set1_epi16(255);
+
+		std::size_t i = 0;
+		for (; i + 8 <= pixelCount; i += 8)
+		{
+			__m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			__m256i alpha = _mm256_srli_epi32(source, 24);
+
+			if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, zero)) == -1)
+				continue;
+
+			if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, _mm256_set1_epi32(255))) == -1)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), source);
+				continue;
+			}
+
+			__m256i destination = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+
+			__m256i alpha32 = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 16));
+			__m256i alphaLo = _mm256_unpacklo_epi32(alpha32, alpha32);
+			__m256i alphaHi = _mm256_unpackhi_epi32(alpha32, alpha32);
+
+			source = _mm256_or_si256(source, alphaMask);
+			__m256i sourceLo = _mm256_unpacklo_epi8(source, zero);
+			__m256i sourceHi = _mm256_unpackhi_epi8(source, zero);
+			__m256i destinationLo = _mm256_unpacklo_epi8(destination, zero);
+			__m256i destinationHi = _mm256_unpackhi_epi8(destination, zero);
+
+			__m256i resultLo = Div255AVX2(_mm256_add_epi16(_mm256_mullo_epi16(sourceLo, alphaLo), _mm256_mullo_epi16(destinationLo, _mm256_sub_epi16(max, alphaLo))));
+			__m256i resultHi = Div255AVX2(_mm256_add_epi16(_mm256_mullo_epi16(sourceHi, alphaHi), _mm256_mullo_epi16(destinationHi, _mm256_sub_epi16(max, alphaHi))));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(resultLo, resultHi));
+		}
+
+		BlendStraightSSE2(dst + i, src + i, pixelCount - i);
+	}
+
+	SDLPP_TARGET("avx2")
+	__m256i BlendPremultipliedAVX2(__m256i source, __m256i destination)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i max = _mm256_set1_epi16(255);
+
+		__m256i alpha = _mm256_srli_epi32(source, 24);
+		__m256i alpha32 = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 16));
+		__m256i inverseAlphaLo = _mm256_sub_epi16(max, _mm256_unpacklo_epi32(alpha32, alpha32));
+		__m256i inverseAlphaHi = _mm256_sub_epi16(max, _mm256_unpackhi_epi32(alpha32, alpha32));
+
+		__m256i resultLo = _mm256_add_epi16(_mm256_unpacklo_epi8(source, zero), Div255AVX2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(destination, zero), inverseAlphaLo)));
+		__m256i resultHi = _mm256_add_epi16(_mm256_unpackhi_epi8(source, zero), Div255AVX2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(destination, zero), inverseAlphaHi)));
+
+		return _mm256_packus_epi16(resultLo, resultHi);
+	}
+
+	SDLPP_TARGET("avx2")
+	void BlendPremultipliedAVX2(Uint32* dst, const Uint32* src, std::size_t pixelCount)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+
+		std::size_t i = 0;
+		for (; i + 8 <= pixelCount; i += 8)
+		{
+			__m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(source, zero)) == -1)
+				continue;
+
+			if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_srli_epi32(source, 24), _mm256_set1_epi32(255))) == -1)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), source);
+				continue;
+			}
+
+			__m256i destination = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), BlendPremultipliedAVX2(source, destination));
+		}
+
+		BlendPremultipliedSSE2(dst + i, src + i, pixelCount - i);
+	}
+
+	SDLPP_TARGET("avx2")
+	void FillPremultipliedAVX2(Uint32* dst, Uint32 color, std::size_t pixelCount)
+	{
+		if (color == 0)
+			return;
+
+		__m256i source = _mm256_set1_epi32(static_cast<int>(color));
+		bool opaque = (color >> 24) == 255;
+
+		std::size_t i = 0;
+		for (; i + 8 <= pixelCount; i += 8)
+		{
+			__m256i* pixels = reinterpret_cast<__m256i*>(dst + i);
+			_mm256_storeu_si256(pixels, (opaque) ? source : BlendPremultipliedAVX2(source, _mm256_loadu_si256(pixels)));
+		}
+
+		FillPremultipliedSSE2(dst + i, color, pixelCount - i);
+	}
+#endif
+
+	const SDLppBlitKernels ScalarKernels = { SDLppBlitBackend::Scalar, &BlendStraightScalar, &BlendPremultipliedScalar, &FillPremultipliedScalar };
+#ifdef SDLPP_BLIT_X86
+	const SDLppBlitKernels SSE2Kernels = { SDLppBlitBackend::SSE2, &BlendStraightSSE2, &BlendPremultipliedSSE2, &FillPremultipliedSSE2 };
+	const SDLppBlitKernels AVX2Kernels = { SDLppBlitBackend::AVX2, &BlendStraightAVX2, &BlendPremultipliedAVX2, &FillPremultipliedAVX2 };
+#endif
+}
+
+const SDLppBlitKernels& SDLppBlitKernels::Get()
+{
+	static const SDLppBlitKernels& bestKernels = []() -> const SDLppBlitKernels&
+	{
+		if (const SDLppBlitKernels* kernels = Get(SDLppBlitBackend::AVX2))
+			return *kernels;
+
+		if (const SDLppBlitKernels* kernels = Get(SDLppBlitBackend::SSE2))
+			return *kernels;
+
+		return ScalarKernels;
+	}();
+
+	return bestKernels;
+}
+
+const SDLppBlitKernels* SDLppBlitKernels::Get(SDLppBlitBackend backend)
+{
+	switch (backend)
+	{
+		case SDLppBlitBackend::Scalar:
+			return &ScalarKernels;
+
+#ifdef SDLPP_BLIT_X86
+		case SDLppBlitBackend::SSE2:
+			return (SDL_HasSSE2()) ? &SSE2Kernels : nullptr;
+
+		case SDLppBlitBackend::AVX2:
+			return (SDL_HasAVX2()) ? &AVX2Kernels : nullptr;
+#endif
+
+		default:
+			return nullptr;
+	}
+}
\ No newline at end of file
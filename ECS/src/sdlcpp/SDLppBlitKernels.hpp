@@ -0,0 +1,29 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+enum class SDLppBlitBackend
+{
+	Scalar,
+	SSE2,
+	AVX2
+};
+
+// Noyaux de mélange alpha opérant sur une ligne de pixels 32 bits dont l'alpha occupe l'octet de poids fort (ARGB8888, ABGR8888),
+// en versions scalaire, SSE2 et AVX2 : les trois donnent exactement le même résultat, la plus rapide est choisie à l'exécution.
+//
+// Alpha "droit" (straight) : dst = (src * a + dst * (255 - a)) / 255, l'alpha résultant étant a + dst.a * (255 - a) / 255
+// Alpha prémultiplié : dst = src + dst * (255 - a) / 255, sur les quatre composantes
+struct SDLppBlitKernels
+{
+	SDLppBlitBackend backend;
+	void(*blendStraight)(Uint32* dst, const Uint32* src, std::size_t pixelCount);
+	void(*blendPremultiplied)(Uint32* dst, const Uint32* src, std::size_t pixelCount);
+	void(*fillPremultiplied)(Uint32* dst, Uint32 color, std::size_t pixelCount); //< Mélange une couleur (prémultipliée) constante
+
+	// Noyaux de la meilleure version supportée par le processeur (et le compilateur)
+	static const SDLppBlitKernels& Get();
+	// nullptr si cette version n'est pas disponible
+	static const SDLppBlitKernels* Get(SDLppBlitBackend backend);
+};
\ No newline at end of file
@@ -20,6 +20,11 @@ SDLppFont::~SDLppFont()
 		TTF_CloseFont(m_font);
 }
 
+TTF_Font* SDLppFont::GetHandle() const
+{
+	return m_font;
+}
+
 SDLppSurface SDLppFont::RenderUTF8Blended(const std::string& text)
 {
 	SDL_Color white = { 255, 255, 255, 255 };
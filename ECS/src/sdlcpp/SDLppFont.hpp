@@ -12,6 +12,8 @@ public:
 	SDLppFont(SDLppFont&& font);
 	~SDLppFont();
 
+	TTF_Font* GetHandle() const;
+
 	SDLppSurface RenderUTF8Blended(const std::string& text);
 	SDLppSurface RenderUTF8Blended(const std::string& text, const SDL_Color& color);
 
@@ -0,0 +1,182 @@
+#include "SDLppGlyphAtlas.hpp"
+#include "SDLppFont.hpp"
+#include "SDLppRenderer.hpp"
+#include "SDLppSdfFont.hpp"
+#include <SDL2/SDL_ttf.h>
+#include <stdexcept>
+#include <string>
+
+SDLppGlyphAtlas::SDLppGlyphAtlas(const SDLppRenderer& renderer, const SDLppFont& font, int pageSize) :
+m_font(&font),
+m_renderer(renderer),
+m_sdfFont(nullptr),
+m_pageSize(pageSize),
+m_pixelSize(0)
+{
+	m_asciiGlyphs.fill(nullptr);
+}
+
+SDLppGlyphAtlas::SDLppGlyphAtlas(const SDLppRenderer& renderer, SDLppSdfFont& font, int pixelSize, int pageSize) :
+m_font(nullptr),
+m_renderer(renderer),
+m_sdfFont(&font),
+m_pageSize(pageSize),
+m_pixelSize(pixelSize)
+{
+	m_asciiGlyphs.fill(nullptr);
+}
+
+const SDLppGlyph& SDLppGlyphAtlas::GetGlyph(Uint32 codepoint)
+{
+	if (codepoint < m_asciiGlyphs.size() && m_asciiGlyphs[codepoint])
+		return *m_asciiGlyphs[codepoint];
+
+	auto it = m_glyphs.find(codepoint);
+	if (it != m_glyphs.end())
+		return it->second;
+
+	return RasterizeGlyph(codepoint);
+}
+
+int SDLppGlyphAtlas::GetKerning(Uint32 previousCodepoint, Uint32 codepoint) const
+{
+	if (m_sdfFont)
+		return m_sdfFont->GetKerning(previousCodepoint, codepoint, m_pixelSize);
+
+	return TTF_GetFontKerningSizeGlyphs32(m_font->GetHandle(), previousCodepoint, codepoint);
+}
+
+int SDLppGlyphAtlas::GetLineSkip() const
+{
+	if (m_sdfFont)
+		return m_sdfFont->GetLineSkip(m_pixelSize);
+
+	return TTF_FontLineSkip(m_font->GetHandle());
+}
+
+const SDLppTexture& SDLppGlyphAtlas::GetPage(std::size_t pageIndex) const
+{
+	return m_pages[pageIndex].texture;
+}
+
+std::size_t SDLppGlyphAtlas::GetPageCount() const
+{
+	return m_pages.size();
+}
+
+int SDLppGlyphAtlas::GetPageSize() const
+{
+	return m_pageSize;
+}
+
+Uint32 SDLppGlyphAtlas::DecodeUTF8(std::string_view text, std::size_t& offset)
+{
+	constexpr Uint32 ReplacementCharacter = 0xFFFD;
+
+	unsigned char lead = static_cast<unsigned char>(text[offset++]);
+	if (lead < 0x80)
+		return lead;
+
+	std::size_t continuationCount;
+	Uint32 codepoint;
+	if ((lead & 0xE0) == 0xC0)
+	{
+		continuationCount = 1;
+		codepoint = lead & 0x1F;
+	}
+	else if ((lead & 0xF0) == 0xE0)
+	{
+		continuationCount = 2;
+		codepoint = lead & 0x0F;
+	}
+	else if ((lead & 0xF8) == 0xF0)
+	{
+		continuationCount = 3;
+		codepoint = lead & 0x07;
+	}
+	else
+		return ReplacementCharacter;
+
+	for (std::size_t i = 0; i < continuationCount; ++i)
+	{
+		if (offset >= text.size() || (static_cast<unsigned char>(text[offset]) & 0xC0) != 0x80)
+			return ReplacementCharacter;
+
+		codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[offset++]) & 0x3F);
+	}
+
+	return codepoint;
+}
+
+const SDLppGlyph& SDLppGlyphAtlas::RasterizeGlyph(Uint32 codepoint)
+{
+	SDLppGlyph glyph;
+	glyph.rect = SDL_Rect{ 0, 0, 0, 0 };
+	glyph.page = 0;
+
+	SDLppSurface surface = RenderGlyph(codepoint, glyph.advance);
+	if (SDL_Surface* glyphSurface = surface.GetHandle())
+	{
+		// Un pixel d'écart entre les glyphes évite qu'un glyphe ne déborde sur son voisin lors du filtrage
+		SDL_Rect paddedRect;
+		if (m_pages.empty() || !m_pages.back().packer.Insert(glyphSurface->w + 1, glyphSurface->h + 1, paddedRect))
+		{
+			SDL_Texture* texture = SDL_CreateTexture(m_renderer.GetHandle(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, m_pageSize, m_pageSize);
+			if (!texture)
+				throw std::runtime_error(std::string("failed to create glyph atlas page: ") + SDL_GetError());
+
+			// Le contenu d'une texture n'est pas initialisé
+			std::vector<Uint32> transparentPixels(static_cast<std::size_t>(m_pageSize) * m_pageSize, 0);
+			SDL_UpdateTexture(texture, nullptr, transparentPixels.data(), m_pageSize * sizeof(Uint32));
+			SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+			m_pages.push_back(Page{ SDLppTexture(texture), SDLppSkylinePacker(m_pageSize, m_pageSize) });
+			if (!m_pages.back().packer.Insert(glyphSurface->w + 1, glyphSurface->h + 1, paddedRect))
+				throw std::runtime_error("glyph of codepoint " + std::to_string(codepoint) + " does not fit in a glyph atlas page");
+		}
+
+		glyph.rect = SDL_Rect{ paddedRect.x, paddedRect.y, glyphSurface->w, glyphSurface->h };
+		glyph.page = m_pages.size() - 1;
+
+		SDL_UpdateTexture(m_pages.back().texture.GetHandle(), &glyph.rect, glyphSurface->pixels, glyphSurface->pitch);
+	}
+
+	const SDLppGlyph& insertedGlyph = m_glyphs.emplace(codepoint, glyph).first->second;
+	if (codepoint < m_asciiGlyphs.size())
+		m_asciiGlyphs[codepoint] = &insertedGlyph;
+
+	return insertedGlyph;
+}
+
+SDLppSurface SDLppGlyphAtlas::RenderGlyph(Uint32 codepoint, int& advance) const
+{
+	if (m_sdfFont)
+		return m_sdfFont->RenderGlyph(codepoint, m_pixelSize, advance);
+
+	int minX, maxX, minY, maxY;
+	if (TTF_GlyphMetrics32(m_font->GetHandle(), codepoint, &minX, &maxX, &minY, &maxY, &advance) != 0)
+		advance = 0;
+
+	// Le glyphe est rendu en blanc, sa couleur est donnée à l'affichage par celle des sommets
+	SDL_Color white = { 255, 255, 255, 255 };
+	SDL_Surface* rendered = TTF_RenderGlyph32_Blended(m_font->GetHandle(), codepoint, white);
+	if (!rendered || rendered->w <= 0 || rendered->h <= 0)
+	{
+		if (rendered)
+			SDL_FreeSurface(rendered);
+
+		return SDLppSurface(nullptr);
+	}
+
+	SDLppSurface surface(rendered);
+	if (rendered->format->format != SDL_PIXELFORMAT_ARGB8888)
+	{
+		SDL_Surface* converted = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+		if (!converted)
+			throw std::runtime_error(std::string("failed to convert glyph: ") + SDL_GetError());
+
+		surface = SDLppSurface(converted);
+	}
+
+	return surface;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "SDLppSkylinePacker.hpp"
+#include "SDLppSurface.hpp"
+#include "SDLppTexture.hpp"
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class SDLppFont;
+class SDLppRenderer;
+class SDLppSdfFont;
+
+struct SDLppGlyph
+{
+	SDL_Rect rect;     //< Dans la page de l'atlas, vide pour un glyphe invisible (comme l'espace)
+	std::size_t page;
+	int advance;       //< Déplacement du stylo après ce glyphe
+};
+
+// Atlas des glyphes d'une police (à une taille donnée), rempli au fur et à mesure que de nouveaux caractères sont affichés :
+// chaque glyphe n'est rastérisé qu'une fois, un texte changeant à chaque frame ne coûte alors plus que l'envoi de ses quads.
+// Les glyphes viennent soit de SDL_ttf, soit du champ de distance d'une SDLppSdfFont (voir SDLppSdfFont::GetAtlas)
+class SDLppGlyphAtlas
+{
+public:
+	SDLppGlyphAtlas(const SDLppRenderer& renderer, const SDLppFont& font, int pageSize = 512);
+	SDLppGlyphAtlas(const SDLppRenderer& renderer, SDLppSdfFont& font, int pixelSize, int pageSize = 512);
+	SDLppGlyphAtlas(const SDLppGlyphAtlas&) = delete;
+	SDLppGlyphAtlas(SDLppGlyphAtlas&&) = delete;
+	~SDLppGlyphAtlas() = default;
+
+	const SDLppGlyph& GetGlyph(Uint32 codepoint);
+	int GetKerning(Uint32 previousCodepoint, Uint32 codepoint) const;
+	int GetLineSkip() const;
+	const SDLppTexture& GetPage(std::size_t pageIndex) const;
+	std::size_t GetPageCount() const;
+	int GetPageSize() const;
+
+	SDLppGlyphAtlas& operator=(const SDLppGlyphAtlas&) = delete;
+	SDLppGlyphAtlas& operator=(SDLppGlyphAtlas&&) = delete;
+
+	// Lit le caractère commençant à offset et avance ce dernier, U+FFFD si la séquence est invalide
+	static Uint32 DecodeUTF8(std::string_view text, std::size_t& offset);
+
+private:
+	struct Page
+	{
+		SDLppTexture texture;
+		SDLppSkylinePacker packer;
+	};
+
+	const SDLppGlyph& RasterizeGlyph(Uint32 codepoint);
+	SDLppSurface RenderGlyph(Uint32 codepoint, int& advance) const;
+
+	std::array<const SDLppGlyph*, 128> m_asciiGlyphs; //< Accès direct aux caractères les plus courants
+	std::unordered_map<Uint32, SDLppGlyph> m_glyphs;
+	std::vector<Page> m_pages;
+	const SDLppFont* m_font;
+	const SDLppRenderer& m_renderer;
+	SDLppSdfFont* m_sdfFont;
+	int m_pageSize;
+	int m_pixelSize;   //< Taille demandée à m_sdfFont
+};
\ No newline at end of file
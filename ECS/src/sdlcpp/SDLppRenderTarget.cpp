@@ -0,0 +1,117 @@
+#include "SDLppRenderTarget.hpp"
+#include "SDLppRenderer.hpp"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+	SDL_Texture* CreateTargetTexture(const SDLppRenderer& renderer, int width, int height)
+	{
+		SDL_Texture* texture = SDL_CreateTexture(renderer.GetHandle(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+		if (!texture)
+			throw std::runtime_error(std::string("failed to create render target: ") + SDL_GetError());
+
+		// Les parties du calque où rien n'est dessiné laissent voir ce qui se trouve dessous
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+		return texture;
+	}
+
+	// Sauvegarde de l'état du renderer modifié par le passage à une autre cible (cible, couleur, viewport et clip rect),
+	// rétabli à la destruction : même si le dessin lève une exception, le renderer ne reste pas bloqué sur le calque
+	class RenderStateGuard
+	{
+	public:
+		RenderStateGuard(SDL_Renderer* renderer) :
+		m_renderer(renderer)
+		{
+			m_target = SDL_GetRenderTarget(m_renderer);
+			SDL_GetRenderDrawColor(m_renderer, &m_color.r, &m_color.g, &m_color.b, &m_color.a);
+			SDL_RenderGetViewport(m_renderer, &m_viewport);
+			SDL_RenderGetClipRect(m_renderer, &m_clipRect);
+			m_clipEnabled = (SDL_RenderIsClipEnabled(m_renderer) == SDL_TRUE);
+		}
+
+		RenderStateGuard(const RenderStateGuard&) = delete;
+		RenderStateGuard(RenderStateGuard&&) = delete;
+
+		~RenderStateGuard()
+		{
+			// Changer de cible réinitialise le viewport et le clip rect, qui ne sont donc rétablis qu'ensuite
+			SDL_SetRenderTarget(m_renderer, m_target);
+			SDL_SetRenderDrawColor(m_renderer, m_color.r, m_color.g, m_color.b, m_color.a);
+			SDL_RenderSetViewport(m_renderer, &m_viewport);
+			SDL_RenderSetClipRect(m_renderer, (m_clipEnabled) ? &m_clipRect : nullptr);
+		}
+
+		RenderStateGuard& operator=(const RenderStateGuard&) = delete;
+		RenderStateGuard& operator=(RenderStateGuard&&) = delete;
+
+	private:
+		SDL_Renderer* m_renderer;
+		SDL_Texture* m_target;
+		SDL_Color m_color;
+		SDL_Rect m_viewport;
+		SDL_Rect m_clipRect;
+		bool m_clipEnabled;
+	};
+}
+
+SDLppRenderTarget::SDLppRenderTarget(const SDLppRenderer& renderer, int width, int height, DrawCallback drawCallback) :
+m_drawCallback(std::move(drawCallback)),
+m_texture(CreateTargetTexture(renderer, width, height)),
+m_height(height),
+m_width(width),
+m_invalidated(true)
+{
+}
+
+int SDLppRenderTarget::GetHeight() const
+{
+	return m_height;
+}
+
+const SDLppTexture& SDLppRenderTarget::GetTexture() const
+{
+	return m_texture;
+}
+
+int SDLppRenderTarget::GetWidth() const
+{
+	return m_width;
+}
+
+void SDLppRenderTarget::Invalidate()
+{
+	m_invalidated = true;
+}
+
+bool SDLppRenderTarget::IsInvalidated() const
+{
+	return m_invalidated;
+}
+
+void SDLppRenderTarget::Redraw(SDLppRenderer& renderer)
+{
+	// Le calque peut être redessiné pendant qu'une autre cible est active (un calque dans un autre, ou dans le DirtyRectRenderer),
+	// éventuellement limitée à un clip rect ou à un viewport
+	{
+		RenderStateGuard stateGuard(renderer.GetHandle());
+
+		renderer.SetTarget(*this);
+		renderer.SetDrawColor(0, 0, 0, 0);
+		renderer.Clear();
+
+		if (m_drawCallback)
+			m_drawCallback(renderer);
+	}
+
+	m_invalidated = false;
+}
+
+void SDLppRenderTarget::SetDrawCallback(DrawCallback drawCallback)
+{
+	m_drawCallback = std::move(drawCallback);
+	m_invalidated = true;
+}
\ No newline at end of file
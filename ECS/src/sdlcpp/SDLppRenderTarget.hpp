@@ -0,0 +1,45 @@
+#pragma once
+
+#include "SDLppTexture.hpp"
+#include <SDL2/SDL.h>
+#include <functional>
+
+class SDLppRenderer;
+
+// Texture dans laquelle le renderer peut dessiner (SDL_TEXTUREACCESS_TARGET), utilisable comme calque :
+// un décor statique (fond, tuiles, obstacles) y est dessiné une fois par son DrawCallback, puis affiché d'une seule copie
+// par SDLppRenderer::DrawLayer à chaque frame, jusqu'à ce qu'il soit invalidé parce que son contenu a changé.
+// Le contenu des textures cibles peut être perdu (événement SDL_RENDER_TARGETS_RESET) : il faut alors invalider les calques.
+class SDLppRenderTarget
+{
+public:
+	using DrawCallback = std::function<void(SDLppRenderer& renderer)>;
+
+	SDLppRenderTarget(const SDLppRenderer& renderer, int width, int height, DrawCallback drawCallback = nullptr);
+	SDLppRenderTarget(const SDLppRenderTarget&) = delete;
+	SDLppRenderTarget(SDLppRenderTarget&&) = default;
+	~SDLppRenderTarget() = default;
+
+	int GetHeight() const;
+	const SDLppTexture& GetTexture() const;
+	int GetWidth() const;
+
+	void Invalidate();
+	bool IsInvalidated() const;
+
+	// Efface la texture (en transparent) et y dessine le calque via le DrawCallback, l'ancienne cible du renderer est ensuite rétablie
+	// (avec sa couleur, son viewport et son clip rect), y compris si le DrawCallback lève une exception
+	void Redraw(SDLppRenderer& renderer);
+
+	void SetDrawCallback(DrawCallback drawCallback);
+
+	SDLppRenderTarget& operator=(const SDLppRenderTarget&) = delete;
+	SDLppRenderTarget& operator=(SDLppRenderTarget&&) = default;
+
+private:
+	DrawCallback m_drawCallback;
+	SDLppTexture m_texture;
+	int m_height;
+	int m_width;
+	bool m_invalidated;
+};
\ No newline at end of file
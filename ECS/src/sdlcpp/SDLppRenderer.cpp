@@ -1,4 +1,10 @@
 #include "SDLppRenderer.hpp"
+#include "SDLppGlyphAtlas.hpp"
+#include "SDLppRenderTarget.hpp"
+#include "SDLppTextLayout.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <stdexcept>
 
 SDLppRenderer::SDLppRenderer(SDL_Renderer* renderer) :
@@ -8,6 +14,9 @@ m_renderer(renderer)
 
 SDLppRenderer::SDLppRenderer(SDLppRenderer&& renderer)
 {
+	m_pendingTextures = std::move(renderer.m_pendingTextures);
+	m_textVertices = std::move(renderer.m_textVertices);
+	m_textIndices = std::move(renderer.m_textIndices);
 	m_renderer = renderer.m_renderer;
 	renderer.m_renderer = nullptr;
 }
@@ -38,28 +47,254 @@ void SDLppRenderer::Copy(const SDLppTexture& texture, const SDL_Rect& srcRect, c
 	SDL_RenderCopy(m_renderer, texture.GetHandle(), &srcRect, &dstRect);
 }
 
+void SDLppRenderer::DrawText(SDLppGlyphAtlas& glyphAtlas, std::string_view text, int x, int y, const SDL_Color& color)
+{
+	// Les glyphes manquants sont d'abord ajoutés à l'atlas, ce qui peut créer une nouvelle page,
+	// puis chaque page utilisée par le texte est affichée en un seul appel
+	std::size_t firstPage = SIZE_MAX;
+	std::size_t lastPage = 0;
+	for (std::size_t offset = 0; offset < text.size();)
+	{
+		Uint32 codepoint = SDLppGlyphAtlas::DecodeUTF8(text, offset);
+		if (codepoint == '\n')
+			continue;
+
+		const SDLppGlyph& glyph = glyphAtlas.GetGlyph(codepoint);
+		if (!SDL_RectEmpty(&glyph.rect))
+		{
+			firstPage = std::min(firstPage, glyph.page);
+			lastPage = std::max(lastPage, glyph.page);
+		}
+	}
+
+	float pageSize = static_cast<float>(glyphAtlas.GetPageSize());
+	for (std::size_t pageIndex = firstPage; pageIndex <= lastPage && firstPage != SIZE_MAX; ++pageIndex)
+	{
+		m_textVertices.clear();
+		m_textIndices.clear();
+
+		int penX = x;
+		int penY = y;
+		Uint32 previousCodepoint = 0;
+		for (std::size_t offset = 0; offset < text.size();)
+		{
+			Uint32 codepoint = SDLppGlyphAtlas::DecodeUTF8(text, offset);
+			if (codepoint == '\n')
+			{
+				penX = x;
+				penY += glyphAtlas.GetLineSkip();
+				previousCodepoint = 0;
+				continue;
+			}
+
+			if (previousCodepoint != 0)
+				penX += glyphAtlas.GetKerning(previousCodepoint, codepoint);
+
+			const SDLppGlyph& glyph = glyphAtlas.GetGlyph(codepoint);
+			if (glyph.page == pageIndex && !SDL_RectEmpty(&glyph.rect))
+				AddGlyphQuad(glyph.rect, penX, penY, pageSize, color);
+
+			penX += glyph.advance;
+			previousCodepoint = codepoint;
+		}
+
+		if (!m_textIndices.empty())
+			SDL_RenderGeometry(m_renderer, glyphAtlas.GetPage(pageIndex).GetHandle(), m_textVertices.data(), static_cast<int>(m_textVertices.size()), m_textIndices.data(), static_cast<int>(m_textIndices.size()));
+	}
+}
+
+void SDLppRenderer::DrawText(const SDLppTextLayout& textLayout, int x, int y, const SDL_Color& color)
+{
+	if (textLayout.GetParagraphCount() == 0)
+		return;
+
+	// Seuls les paragraphes recoupant la zone d'affichage sont envoyés
+	SDL_Rect viewport;
+	SDL_RenderGetViewport(m_renderer, &viewport);
+
+	if (y + textLayout.GetHeight() <= 0 || y >= viewport.h)
+		return;
+
+	std::size_t firstParagraph = textLayout.GetParagraphAt(-y);
+	std::size_t lastParagraph = textLayout.GetParagraphAt(viewport.h - 1 - y);
+
+	std::size_t firstPage = SIZE_MAX;
+	std::size_t lastPage = 0;
+	for (std::size_t paragraphIndex = firstParagraph; paragraphIndex <= lastParagraph; ++paragraphIndex)
+	{
+		for (const SDLppPositionedGlyph& glyph : textLayout.GetParagraphGlyphs(paragraphIndex))
+		{
+			firstPage = std::min(firstPage, glyph.page);
+			lastPage = std::max(lastPage, glyph.page);
+		}
+	}
+
+	const SDLppGlyphAtlas& glyphAtlas = textLayout.GetGlyphAtlas();
+	float pageSize = static_cast<float>(glyphAtlas.GetPageSize());
+	for (std::size_t pageIndex = firstPage; pageIndex <= lastPage && firstPage != SIZE_MAX; ++pageIndex)
+	{
+		m_textVertices.clear();
+		m_textIndices.clear();
+
+		for (std::size_t paragraphIndex = firstParagraph; paragraphIndex <= lastParagraph; ++paragraphIndex)
+		{
+			int paragraphY = y + textLayout.GetParagraphTop(paragraphIndex);
+			for (const SDLppPositionedGlyph& glyph : textLayout.GetParagraphGlyphs(paragraphIndex))
+			{
+				if (glyph.page == pageIndex)
+					AddGlyphQuad(glyph.rect, x + glyph.x, paragraphY + glyph.y, pageSize, color);
+			}
+		}
+
+		if (!m_textIndices.empty())
+			SDL_RenderGeometry(m_renderer, glyphAtlas.GetPage(pageIndex).GetHandle(), m_textVertices.data(), static_cast<int>(m_textVertices.size()), m_textIndices.data(), static_cast<int>(m_textIndices.size()));
+	}
+}
+
+void SDLppRenderer::DrawLayer(SDLppRenderTarget& layer)
+{
+	if (layer.IsInvalidated())
+		layer.Redraw(*this);
+
+	Copy(layer.GetTexture());
+}
+
+void SDLppRenderer::DrawLayer(SDLppRenderTarget& layer, const SDL_Rect& dstRect)
+{
+	if (layer.IsInvalidated())
+		layer.Redraw(*this);
+
+	Copy(layer.GetTexture(), dstRect);
+}
+
+void SDLppRenderer::FillRect(const SDL_Rect& rect)
+{
+	SDL_RenderFillRect(m_renderer, &rect);
+}
+
 SDL_Renderer* SDLppRenderer::GetHandle() const
 {
 	return m_renderer;
 }
 
+std::size_t SDLppRenderer::GetPendingTextureCount() const
+{
+	return m_pendingTextures.size();
+}
+
+std::future<std::shared_ptr<SDLppTexture>> SDLppRenderer::LoadTextureAsync(std::string filepath)
+{
+	PendingTexture& pendingTexture = m_pendingTextures.emplace_back();
+	pendingTexture.surface = SDLppSurface::FromFileAsync(std::move(filepath));
+
+	return pendingTexture.texture.get_future();
+}
+
 void SDLppRenderer::Present()
 {
 	SDL_RenderPresent(m_renderer);
 }
 
+void SDLppRenderer::ResetClipRect()
+{
+	SDL_RenderSetClipRect(m_renderer, nullptr);
+}
+
+void SDLppRenderer::SetClipRect(const SDL_Rect& rect)
+{
+	SDL_RenderSetClipRect(m_renderer, &rect);
+}
+
+void SDLppRenderer::ResetTarget()
+{
+	SDL_SetRenderTarget(m_renderer, nullptr);
+}
+
+void SDLppRenderer::SetTarget(const SDLppRenderTarget& target)
+{
+	if (SDL_SetRenderTarget(m_renderer, target.GetTexture().GetHandle()) != 0)
+		throw std::runtime_error(std::string("failed to set render target: ") + SDL_GetError());
+}
+
 void SDLppRenderer::SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
 	SDL_SetRenderDrawColor(m_renderer, r, g, b, a);
 }
 
+std::size_t SDLppRenderer::UploadPendingTextures(float timeBudget)
+{
+	// La création d'une texture (envoi des pixels au GPU) doit se faire sur le thread du renderer,
+	// on en limite le nombre par frame pour qu'un chargement massif n'en fasse pas sauter une
+	auto start = std::chrono::steady_clock::now();
+
+	std::size_t uploadedCount = 0;
+	std::size_t keptCount = 0;
+	for (std::size_t i = 0; i < m_pendingTextures.size(); ++i)
+	{
+		PendingTexture& pendingTexture = m_pendingTextures[i];
+
+		bool overBudget = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() >= timeBudget;
+		if (overBudget || pendingTexture.surface.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			if (keptCount != i)
+				m_pendingTextures[keptCount] = std::move(pendingTexture);
+
+			keptCount++;
+			continue;
+		}
+
+		// Une erreur de chargement est transmise à celui qui attend la texture
+		try
+		{
+			pendingTexture.texture.set_value(SDLppTexture::FromSurface(*this, pendingTexture.surface.get()));
+		}
+		catch (...)
+		{
+			pendingTexture.texture.set_exception(std::current_exception());
+		}
+
+		uploadedCount++;
+	}
+
+	m_pendingTextures.resize(keptCount);
+
+	return uploadedCount;
+}
+
 SDLppRenderer& SDLppRenderer::operator=(SDLppRenderer&& renderer)
 {
 	if (m_renderer)
 		SDL_DestroyRenderer(m_renderer);
 
+	m_pendingTextures = std::move(renderer.m_pendingTextures);
+	m_textVertices = std::move(renderer.m_textVertices);
+	m_textIndices = std::move(renderer.m_textIndices);
 	m_renderer = renderer.m_renderer;
 	renderer.m_renderer = nullptr;
 
 	return *this;
 }
+
+void SDLppRenderer::AddGlyphQuad(const SDL_Rect& glyphRect, int x, int y, float pageSize, const SDL_Color& color)
+{
+	// Deux triangles par glyphe
+	int firstVertex = static_cast<int>(m_textVertices.size());
+
+	float left = static_cast<float>(x);
+	float top = static_cast<float>(y);
+	float right = left + glyphRect.w;
+	float bottom = top + glyphRect.h;
+
+	float u0 = glyphRect.x / pageSize;
+	float v0 = glyphRect.y / pageSize;
+	float u1 = (glyphRect.x + glyphRect.w) / pageSize;
+	float v1 = (glyphRect.y + glyphRect.h) / pageSize;
+
+	m_textVertices.push_back(SDL_Vertex{ { left, top }, color, { u0, v0 } });
+	m_textVertices.push_back(SDL_Vertex{ { right, top }, color, { u1, v0 } });
+	m_textVertices.push_back(SDL_Vertex{ { right, bottom }, color, { u1, v1 } });
+	m_textVertices.push_back(SDL_Vertex{ { left, bottom }, color, { u0, v1 } });
+
+	for (int index : { 0, 1, 2, 0, 2, 3 })
+		m_textIndices.push_back(firstVertex + index);
+}
\ No newline at end of file
@@ -2,7 +2,16 @@
 
 #include "SDLppTexture.hpp"
 #include <SDL2/SDL.h>
+#include <cstddef>
+#include <future>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
+
+class SDLppGlyphAtlas;
+class SDLppRenderTarget;
+class SDLppTextLayout;
 
 class SDLppRenderer
 {
@@ -18,15 +27,52 @@ public:
 	void Copy(const SDLppTexture& texture, const SDL_Rect& dstRect);
 	void Copy(const SDLppTexture& texture, const SDL_Rect& srcRect, const SDL_Rect& dstRect);
 
+	// Affiche un texte UTF-8 (sur plusieurs lignes s'il contient des \n), en un seul envoi de quads par page de l'atlas
+	void DrawText(SDLppGlyphAtlas& glyphAtlas, std::string_view text, int x, int y, const SDL_Color& color = { 255, 255, 255, 255 });
+	// Affiche un texte déjà mis en page, à partir de son coin supérieur gauche : les paragraphes hors de l'écran sont ignorés
+	void DrawText(const SDLppTextLayout& textLayout, int x, int y, const SDL_Color& color = { 255, 255, 255, 255 });
+
+	// Affiche un calque (sur tout l'écran ou dans dstRect), après l'avoir redessiné s'il a été invalidé
+	void DrawLayer(SDLppRenderTarget& layer);
+	void DrawLayer(SDLppRenderTarget& layer, const SDL_Rect& dstRect);
+
+	void FillRect(const SDL_Rect& rect);
+
 	SDL_Renderer* GetHandle() const;
+	std::size_t GetPendingTextureCount() const;
+
+	// L'image est décodée sur un thread en arrière-plan, la texture n'est créée que par UploadPendingTextures
+	std::future<std::shared_ptr<SDLppTexture>> LoadTextureAsync(std::string filepath);
 
 	void Present();
 
+	// Restreint l'affichage à un rectangle (de la cible courante)
+	void ResetClipRect();
+	void SetClipRect(const SDL_Rect& rect);
+
+	// Redirige l'affichage vers une texture cible, jusqu'à ResetTarget
+	void ResetTarget();
+	void SetTarget(const SDLppRenderTarget& target);
+
 	void SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = SDL_ALPHA_OPAQUE);
 
+	// À appeler à chaque frame : crée les textures des images décodées depuis, tant que timeBudget (en secondes) n'est pas dépassé
+	std::size_t UploadPendingTextures(float timeBudget);
+
 	SDLppRenderer& operator=(const SDLppRenderer&) = delete;
 	SDLppRenderer& operator=(SDLppRenderer&& renderer);
 
 private:
+	struct PendingTexture
+	{
+		std::future<SDLppSurface> surface;
+		std::promise<std::shared_ptr<SDLppTexture>> texture;
+	};
+
+	void AddGlyphQuad(const SDL_Rect& glyphRect, int x, int y, float pageSize, const SDL_Color& color);
+
+	std::vector<PendingTexture> m_pendingTextures;
+	std::vector<SDL_Vertex> m_textVertices;
+	std::vector<int> m_textIndices;
 	SDL_Renderer* m_renderer;
 };
\ No newline at end of file
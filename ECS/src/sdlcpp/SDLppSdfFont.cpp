@@ -0,0 +1,307 @@
+#include "SDLppSdfFont.hpp"
+#include "SDLppFont.hpp"
+#include "SDLppGlyphAtlas.hpp"
+#include <SDL2/SDL_ttf.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	// Transformée de distance euclidienne en deux passes (8SSEDT) : chaque pixel retient le décalage vers le pixel source
+	// (de décalage nul au départ) le plus proche, propagé depuis ses voisins de haut en bas puis de bas en haut
+	struct Offset
+	{
+		int dx;
+		int dy;
+
+		int GetSquaredLength() const { return dx * dx + dy * dy; }
+	};
+
+	void ComputeDistances(std::vector<Offset>& grid, int width, int height)
+	{
+		auto Compare = [&](Offset& offset, int x, int y, int offsetX, int offsetY)
+		{
+			int neighbourX = x + offsetX;
+			int neighbourY = y + offsetY;
+			if (neighbourX < 0 || neighbourX >= width || neighbourY < 0 || neighbourY >= height)
+				return;
+
+			Offset candidate = grid[neighbourY * width + neighbourX];
+			candidate.dx += offsetX;
+			candidate.dy += offsetY;
+
+			if (candidate.GetSquaredLength() < offset.GetSquaredLength())
+				offset = candidate;
+		};
+
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				Offset& offset = grid[y * width + x];
+				Compare(offset, x, y, -1, 0);
+				Compare(offset, x, y, 0, -1);
+				Compare(offset, x, y, -1, -1);
+				Compare(offset, x, y, 1, -1);
+			}
+
+			for (int x = width - 1; x >= 0; --x)
+				Compare(grid[y * width + x], x, y, 1, 0);
+		}
+
+		for (int y = height - 1; y >= 0; --y)
+		{
+			for (int x = width - 1; x >= 0; --x)
+			{
+				Offset& offset = grid[y * width + x];
+				Compare(offset, x, y, 1, 0);
+				Compare(offset, x, y, 0, 1);
+				Compare(offset, x, y, -1, 1);
+				Compare(offset, x, y, 1, 1);
+			}
+
+			for (int x = 0; x < width; ++x)
+				Compare(grid[y * width + x], x, y, -1, 0);
+		}
+	}
+}
+
+SDLppSdfFont::SDLppSdfFont(const SDLppRenderer& renderer, const SDLppFont& font, int spread, std::size_t maxAtlasCount) :
+m_font(font),
+m_renderer(renderer),
+m_atlasUseCounter(0),
+m_maxAtlasCount(std::max<std::size_t>(maxAtlasCount, 1)),
+m_referenceSize(TTF_FontLineSkip(font.GetHandle())),
+m_spread(spread)
+{
+}
+
+SDLppSdfFont::~SDLppSdfFont() = default;
+
+SDLppGlyphAtlas& SDLppSdfFont::GetAtlas(int pixelSize)
+{
+	auto it = m_atlases.find(pixelSize);
+	if (it == m_atlases.end())
+	{
+		// Des pages à la mesure de la taille du texte, pour ne pas réserver 1 Mio pour un texte en 12 pixels
+		int pageSize = 128;
+		while (pageSize < pixelSize * 8 && pageSize < 1024)
+			pageSize *= 2;
+
+		// Place au nouvel atlas : on détruit celui qui n'a pas servi depuis le plus longtemps
+		if (m_atlases.size() >= m_maxAtlasCount)
+		{
+			auto leastRecentlyUsed = std::min_element(m_atlases.begin(), m_atlases.end(), [](const auto& first, const auto& second)
+			{
+				return first.second.lastUse < second.second.lastUse;
+			});
+
+			m_atlases.erase(leastRecentlyUsed);
+		}
+
+		it = m_atlases.emplace(pixelSize, Atlas{ std::make_unique<SDLppGlyphAtlas>(m_renderer, *this, pixelSize, pageSize), 0 }).first;
+	}
+
+	it->second.lastUse = ++m_atlasUseCounter;
+	return *it->second.atlas;
+}
+
+int SDLppSdfFont::GetKerning(Uint32 previousCodepoint, Uint32 codepoint, int pixelSize) const
+{
+	int kerning = TTF_GetFontKerningSizeGlyphs32(m_font.GetHandle(), previousCodepoint, codepoint);
+	return static_cast<int>(std::lround(kerning * static_cast<float>(pixelSize) / m_referenceSize));
+}
+
+int SDLppSdfFont::GetLineSkip(int pixelSize) const
+{
+	return pixelSize;
+}
+
+std::size_t SDLppSdfFont::GetMemoryUsage() const
+{
+	std::size_t memoryUsage = 0;
+	for (const auto& [codepoint, distanceField] : m_distanceFields)
+		memoryUsage += distanceField.values.size();
+
+	// Pages des atlas (textures ARGB8888)
+	for (const auto& [pixelSize, atlas] : m_atlases)
+	{
+		std::size_t pageSize = static_cast<std::size_t>(atlas.atlas->GetPageSize());
+		memoryUsage += atlas.atlas->GetPageCount() * pageSize * pageSize * 4;
+	}
+
+	return memoryUsage;
+}
+
+int SDLppSdfFont::GetReferenceSize() const
+{
+	return m_referenceSize;
+}
+
+void SDLppSdfFont::ReleaseAtlas(int pixelSize)
+{
+	m_atlases.erase(pixelSize);
+}
+
+void SDLppSdfFont::ReleaseAtlases()
+{
+	m_atlases.clear();
+}
+
+SDLppSurface SDLppSdfFont::RenderGlyph(Uint32 codepoint, int pixelSize, int& advance)
+{
+	const DistanceField& distanceField = GetDistanceField(codepoint);
+
+	float scale = static_cast<float>(pixelSize) / m_referenceSize;
+	advance = static_cast<int>(std::lround(distanceField.advance * scale));
+
+	if (distanceField.values.empty())
+		return SDLppSurface(nullptr);
+
+	int glyphWidth = distanceField.width - 2 * m_spread;
+	int glyphHeight = distanceField.height - 2 * m_spread;
+	int width = std::max(static_cast<int>(std::ceil(glyphWidth * scale)), 1);
+	int height = std::max(static_cast<int>(std::ceil(glyphHeight * scale)), 1);
+
+	SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+	if (!surface)
+		throw std::runtime_error(std::string("failed to create glyph surface: ") + SDL_GetError());
+
+	SDLppSurface glyphSurface(surface);
+
+	// Un pixel de l'image couvre 1 / scale pixels du champ : la transition de l'opacité est étalée sur un pixel de l'image,
+	// ce qui donne des contours lissés quelle que soit la taille
+	float unitDistance = m_spread / 127.f;
+	auto Sample = [&](int x, int y)
+	{
+		x = std::clamp(x, 0, distanceField.width - 1);
+		y = std::clamp(y, 0, distanceField.height - 1);
+		return (distanceField.values[y * distanceField.width + x] - 128.f) * unitDistance;
+	};
+
+	for (int y = 0; y < height; ++y)
+	{
+		Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch);
+		for (int x = 0; x < width; ++x)
+		{
+			// Interpolation bilinéaire du champ au centre du pixel
+			float fieldX = (x + 0.5f) / scale + m_spread - 0.5f;
+			float fieldY = (y + 0.5f) / scale + m_spread - 0.5f;
+			int x0 = static_cast<int>(std::floor(fieldX));
+			int y0 = static_cast<int>(std::floor(fieldY));
+			float fracX = fieldX - x0;
+			float fracY = fieldY - y0;
+
+			float top = Sample(x0, y0) + (Sample(x0 + 1, y0) - Sample(x0, y0)) * fracX;
+			float bottom = Sample(x0, y0 + 1) + (Sample(x0 + 1, y0 + 1) - Sample(x0, y0 + 1)) * fracX;
+			float distance = top + (bottom - top) * fracY;
+
+			float coverage = std::clamp(0.5f - distance * scale, 0.f, 1.f);
+			row[x] = (static_cast<Uint32>(coverage * 255.f + 0.5f) << 24) | 0x00FFFFFF;
+		}
+	}
+
+	return glyphSurface;
+}
+
+auto SDLppSdfFont::GetDistanceField(Uint32 codepoint) -> const DistanceField&
+{
+	auto it = m_distanceFields.find(codepoint);
+	if (it != m_distanceFields.end())
+		return it->second;
+
+	DistanceField distanceField;
+	distanceField.width = 0;
+	distanceField.height = 0;
+
+	int minX, maxX, minY, maxY;
+	if (TTF_GlyphMetrics32(m_font.GetHandle(), codepoint, &minX, &maxX, &minY, &maxY, &distanceField.advance) != 0)
+		distanceField.advance = 0;
+
+	SDL_Color white = { 255, 255, 255, 255 };
+	SDL_Surface* rendered = TTF_RenderGlyph32_Blended(m_font.GetHandle(), codepoint, white);
+	if (rendered && rendered->w > 0 && rendered->h > 0)
+	{
+		SDLppSurface surface(rendered);
+		if (rendered->format->format != SDL_PIXELFORMAT_ARGB8888)
+		{
+			SDL_Surface* converted = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+			if (!converted)
+				throw std::runtime_error(std::string("failed to convert glyph: ") + SDL_GetError());
+
+			surface = SDLppSurface(converted);
+		}
+
+		SDL_Surface* glyphSurface = surface.GetHandle();
+
+		// Le champ déborde du glyphe de spread pixels de chaque côté, pour que l'extérieur proche du contour y figure
+		int width = glyphSurface->w + 2 * m_spread;
+		int height = glyphSurface->h + 2 * m_spread;
+
+		// Opacité du glyphe, nulle dans la marge
+		std::vector<float> coverage(static_cast<std::size_t>(width) * height, 0.f);
+		for (int y = 0; y < glyphSurface->h; ++y)
+		{
+			const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(glyphSurface->pixels) + y * glyphSurface->pitch);
+			for (int x = 0; x < glyphSurface->w; ++x)
+				coverage[(y + m_spread) * width + x + m_spread] = (row[x] >> 24) / 255.f;
+		}
+
+		// Les pixels du contour (partiellement couverts, ou voisins d'un pixel de l'autre côté) servent de sources à la transformée.
+		// Leur opacité situe le contour à l'intérieur du pixel : un pixel couvert à 25% est à un quart de pixel du contour,
+		// ce qui donne au champ une précision bien meilleure que le pixel (indispensable une fois le glyphe agrandi)
+		auto IsInside = [&](int x, int y) { return coverage[y * width + x] >= 0.5f; };
+
+		constexpr int Far = 1 << 14;
+
+		std::vector<Offset> grid(coverage.size(), Offset{ Far, Far });
+		bool hasEdge = false;
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				float pixelCoverage = coverage[y * width + x];
+				bool inside = IsInside(x, y);
+
+				bool isEdge = pixelCoverage > 0.f && pixelCoverage < 1.f;
+				isEdge = isEdge || (x > 0 && IsInside(x - 1, y) != inside) || (x < width - 1 && IsInside(x + 1, y) != inside);
+				isEdge = isEdge || (y > 0 && IsInside(x, y - 1) != inside) || (y < height - 1 && IsInside(x, y + 1) != inside);
+				if (isEdge)
+				{
+					grid[y * width + x] = Offset{ 0, 0 };
+					hasEdge = true;
+				}
+			}
+		}
+
+		// Un glyphe entièrement transparent n'a pas de champ : rien à afficher
+		if (hasEdge)
+		{
+			ComputeDistances(grid, width, height);
+
+			// Distance au contour = distance au pixel source le plus proche, corrigée de la position du contour dans ce dernier
+			distanceField.width = width;
+			distanceField.height = height;
+			distanceField.values.resize(coverage.size());
+			for (int y = 0; y < height; ++y)
+			{
+				for (int x = 0; x < width; ++x)
+				{
+					const Offset& offset = grid[y * width + x];
+					float sourceCoverage = coverage[(y + offset.dy) * width + x + offset.dx];
+
+					float length = std::sqrt(static_cast<float>(offset.GetSquaredLength()));
+					float distance = (IsInside(x, y) ? -length : length) + 0.5f - sourceCoverage;
+
+					distanceField.values[y * width + x] = static_cast<Uint8>(std::clamp(128.f + distance * 127.f / m_spread + 0.5f, 0.f, 255.f));
+				}
+			}
+		}
+	}
+	else if (rendered)
+		SDL_FreeSurface(rendered);
+
+	return m_distanceFields.emplace(codepoint, std::move(distanceField)).first->second;
+}
\ No newline at end of file
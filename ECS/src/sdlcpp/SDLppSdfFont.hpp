@@ -0,0 +1,74 @@
+#pragma once
+
+#include "SDLppSurface.hpp"
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class SDLppFont;
+class SDLppGlyphAtlas;
+class SDLppRenderer;
+
+// Police affichable à n'importe quelle taille à partir d'une seule rastérisation : chaque glyphe est rendu une fois,
+// à la taille d'ouverture de la police (64 est un bon compromis), puis converti en champ de distance signée
+// (distance au contour la plus proche, négative à l'intérieur).
+// Le renderer SDL ne permettant pas de seuiller ce champ à l'affichage (pas de shader), c'est fait sur le processeur :
+// l'image d'un glyphe à une taille donnée s'obtient en ré-échantillonnant son champ, bien plus vite qu'avec SDL_ttf,
+// sans rouvrir la police, et avec des contours nets même agrandis.
+// Seuls les maxAtlasCount atlas utilisés le plus récemment sont conservés (chacun occupant jusqu'à quelques Mio de textures),
+// les autres sont détruits et seront reconstruits à la demande.
+class SDLppSdfFont
+{
+public:
+	SDLppSdfFont(const SDLppRenderer& renderer, const SDLppFont& font, int spread = 8, std::size_t maxAtlasCount = 4);
+	SDLppSdfFont(const SDLppSdfFont&) = delete;
+	SDLppSdfFont(SDLppSdfFont&&) = delete;
+	~SDLppSdfFont();
+
+	// Atlas des glyphes à la hauteur de ligne donnée (en pixels), à passer à SDLppRenderer::DrawText
+	// (l'atlas reste valide jusqu'au prochain appel à GetAtlas pour une autre taille ou à ReleaseAtlas)
+	SDLppGlyphAtlas& GetAtlas(int pixelSize);
+
+	int GetKerning(Uint32 previousCodepoint, Uint32 codepoint, int pixelSize) const;
+	int GetLineSkip(int pixelSize) const;
+	std::size_t GetMemoryUsage() const;
+	int GetReferenceSize() const;
+
+	void ReleaseAtlas(int pixelSize);
+	void ReleaseAtlases();
+
+	// Image du glyphe (blanche, ARGB8888) à la taille donnée, nulle pour un glyphe invisible
+	SDLppSurface RenderGlyph(Uint32 codepoint, int pixelSize, int& advance);
+
+	SDLppSdfFont& operator=(const SDLppSdfFont&) = delete;
+	SDLppSdfFont& operator=(SDLppSdfFont&&) = delete;
+
+private:
+	struct Atlas
+	{
+		std::unique_ptr<SDLppGlyphAtlas> atlas;
+		std::size_t lastUse; //< Valeur de m_atlasUseCounter lors du dernier GetAtlas
+	};
+
+	struct DistanceField
+	{
+		std::vector<Uint8> values; //< 128 sur le contour, une unité valant spread / 127 pixels
+		int width;                 //< Marge de spread pixels comprise
+		int height;
+		int advance;
+	};
+
+	const DistanceField& GetDistanceField(Uint32 codepoint);
+
+	std::map<int, Atlas> m_atlases;
+	std::unordered_map<Uint32, DistanceField> m_distanceFields;
+	const SDLppFont& m_font;
+	const SDLppRenderer& m_renderer;
+	std::size_t m_atlasUseCounter;
+	std::size_t m_maxAtlasCount;
+	int m_referenceSize;
+	int m_spread;
+};
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "SDLppSkylinePacker.hpp"
+#include <algorithm>
+#include <limits>
+
+SDLppSkylinePacker::SDLppSkylinePacker(int width, int height) :
+m_height(height),
+m_width(width)
+{
+	Clear();
+}
+
+void SDLppSkylinePacker::Clear()
+{
+	m_skyline.clear();
+	m_skyline.push_back(Segment{ 0, 0, m_width });
+	m_usedArea = 0;
+	m_usedHeight = 0;
+}
+
+int SDLppSkylinePacker::GetHeight() const
+{
+	return m_height;
+}
+
+int SDLppSkylinePacker::GetUsedArea() const
+{
+	return m_usedArea;
+}
+
+int SDLppSkylinePacker::GetUsedHeight() const
+{
+	return m_usedHeight;
+}
+
+int SDLppSkylinePacker::GetWidth() const
+{
+	return m_width;
+}
+
+bool SDLppSkylinePacker::Insert(int width, int height, SDL_Rect& rect)
+{
+	if (width <= 0 || height <= 0)
+		return false;
+
+	// On cherche la position (au début d'un segment) où le bas du rectangle serait le plus haut,
+	// à égalité celle qui repose sur le segment le plus étroit (pour combler les petits creux en premier)
+	std::size_t bestIndex = m_skyline.size();
+	int bestBottom = std::numeric_limits<int>::max();
+	int bestWidth = std::numeric_limits<int>::max();
+	int bestY = 0;
+
+	for (std::size_t i = 0; i < m_skyline.size(); ++i)
+	{
+		int y;
+		if (!Fit(i, width, height, y))
+			continue;
+
+		int bottom = y + height;
+		if (bottom < bestBottom || (bottom == bestBottom && m_skyline[i].width < bestWidth))
+		{
+			bestIndex = i;
+			bestBottom = bottom;
+			bestWidth = m_skyline[i].width;
+			bestY = y;
+		}
+	}
+
+	if (bestIndex == m_skyline.size())
+		return false;
+
+	rect = SDL_Rect{ m_skyline[bestIndex].x, bestY, width, height };
+
+	// Le rectangle devient un nouveau segment de l'horizon, qui recouvre (en tout ou partie) les segments suivants
+	m_skyline.insert(m_skyline.begin() + bestIndex, Segment{ rect.x, bestY + height, width });
+
+	for (std::size_t i = bestIndex + 1; i < m_skyline.size();)
+	{
+		Segment& previous = m_skyline[i - 1];
+		Segment& segment = m_skyline[i];
+
+		int overlap = previous.x + previous.width - segment.x;
+		if (overlap <= 0)
+			break;
+
+		if (overlap < segment.width)
+		{
+			segment.x += overlap;
+			segment.width -= overlap;
+			break;
+		}
+
+		m_skyline.erase(m_skyline.begin() + i);
+	}
+
+	// Les segments voisins de même hauteur sont fusionnés
+	for (std::size_t i = 1; i < m_skyline.size();)
+	{
+		if (m_skyline[i - 1].y == m_skyline[i].y)
+		{
+			m_skyline[i - 1].width += m_skyline[i].width;
+			m_skyline.erase(m_skyline.begin() + i);
+		}
+		else
+			++i;
+	}
+
+	m_usedArea += width * height;
+	m_usedHeight = std::max(m_usedHeight, bestY + height);
+
+	return true;
+}
+
+bool SDLppSkylinePacker::Fit(std::size_t segmentIndex, int width, int height, int& y) const
+{
+	int x = m_skyline[segmentIndex].x;
+	if (x + width > m_width)
+		return false;
+
+	// Le rectangle repose sur le plus haut des segments qu'il recouvre
+	y = 0;
+	int remainingWidth = width;
+	for (std::size_t i = segmentIndex; remainingWidth > 0; ++i)
+	{
+		y = std::max(y, m_skyline[i].y);
+		if (y + height > m_height)
+			return false;
+
+		remainingWidth -= m_skyline[i].width;
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <vector>
+
+// Range des rectangles dans une zone fixe en suivant la "ligne d'horizon" formée par le haut des rectangles déjà placés :
+// chaque rectangle est posé là où son bas serait le plus haut possible (au plus près de l'origine), ce qui laisse peu de trous
+// quand les rectangles arrivent triés par hauteur décroissante, et reste correct lorsqu'ils arrivent un par un
+class SDLppSkylinePacker
+{
+public:
+	SDLppSkylinePacker(int width, int height);
+	SDLppSkylinePacker(const SDLppSkylinePacker&) = default;
+	SDLppSkylinePacker(SDLppSkylinePacker&&) = default;
+	~SDLppSkylinePacker() = default;
+
+	void Clear();
+
+	int GetHeight() const;
+	int GetUsedArea() const;
+	int GetUsedHeight() const;
+	int GetWidth() const;
+
+	// Renvoie false (sans rien modifier) si le rectangle ne trouve pas de place
+	bool Insert(int width, int height, SDL_Rect& rect);
+
+	SDLppSkylinePacker& operator=(const SDLppSkylinePacker&) = default;
+	SDLppSkylinePacker& operator=(SDLppSkylinePacker&&) = default;
+
+private:
+	struct Segment
+	{
+		int x;
+		int y;
+		int width;
+	};
+
+	bool Fit(std::size_t segmentIndex, int width, int height, int& y) const;
+
+	std::vector<Segment> m_skyline; //< De gauche à droite, couvrant toute la largeur
+	int m_height;
+	int m_usedArea;
+	int m_usedHeight;
+	int m_width;
+};
\ No newline at end of file
@@ -1,6 +1,168 @@
 #include "SDLppSurface.hpp"
 #include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// Threads décodant les images en arrière-plan, partagés par tout le programme
+	class DecodeWorkers
+	{
+	public:
+		DecodeWorkers() :
+		m_stop(false)
+		{
+			// Les décodeurs de SDL_image s'initialisent à leur première utilisation : on le fait ici, avant que plusieurs threads ne s'y risquent
+			IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+
+			// Le décodage est limité par le processeur, on laisse un cœur au thread principal
+			unsigned int workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+			for (unsigned int i = 0; i < workerCount; ++i)
+				m_workers.emplace_back([this] { WorkerLoop(); });
+		}
+
+		DecodeWorkers(const DecodeWorkers&) = delete;
+		DecodeWorkers(DecodeWorkers&&) = delete;
+
+		~DecodeWorkers()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_wakeUpCondition.notify_all();
+
+			for (std::thread& worker : m_workers)
+				worker.join();
+		}
+
+		std::future<SDLppSurface> Push(std::packaged_task<SDLppSurface()> task)
+		{
+			std::future<SDLppSurface> future = task.get_future();
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_tasks.push_back(std::move(task));
+			}
+			m_wakeUpCondition.notify_one();
+
+			return future;
+		}
+
+		DecodeWorkers& operator=(const DecodeWorkers&) = delete;
+		DecodeWorkers& operator=(DecodeWorkers&&) = delete;
+
+		static DecodeWorkers& Instance()
+		{
+			static DecodeWorkers workers;
+			return workers;
+		}
+
+	private:
+		void WorkerLoop()
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			for (;;)
+			{
+				m_wakeUpCondition.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+				if (m_stop)
+					break;
+
+				std::packaged_task<SDLppSurface()> task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+
+				// Une exception levée par le décodage est transmise au std::future par le packaged_task
+				lock.unlock();
+				task();
+				lock.lock();
+			}
+		}
+
+		std::condition_variable m_wakeUpCondition;
+		std::deque<std::packaged_task<SDLppSurface()>> m_tasks;
+		std::mutex m_mutex;
+		std::vector<std::thread> m_workers;
+		bool m_stop;
+	};
+
+	// Noyaux utilisés par Blit, BlitScaled et Fill, modifiables depuis n'importe quel thread par SetBlitBackend
+	std::atomic<const SDLppBlitKernels*>& CurrentBlitKernels()
+	{
+		static std::atomic<const SDLppBlitKernels*> kernels(&SDLppBlitKernels::Get());
+		return kernels;
+	}
+
+	// Les pixels d'une surface RLE ne sont accessibles que pendant qu'elle est verrouillée
+	class SurfaceLock
+	{
+	public:
+		explicit SurfaceLock(SDL_Surface* surface) :
+		m_surface(surface)
+		{
+			if (SDL_MUSTLOCK(m_surface) && SDL_LockSurface(m_surface) != 0)
+				throw std::runtime_error(std::string("failed to lock surface: ") + SDL_GetError());
+		}
+
+		SurfaceLock(const SurfaceLock&) = delete;
+		SurfaceLock(SurfaceLock&&) = delete;
+
+		~SurfaceLock()
+		{
+			if (SDL_MUSTLOCK(m_surface))
+				SDL_UnlockSurface(m_surface);
+		}
+
+		SurfaceLock& operator=(const SurfaceLock&) = delete;
+		SurfaceLock& operator=(SurfaceLock&&) = delete;
+
+	private:
+		SDL_Surface* m_surface;
+	};
+
+	void CheckBlitDestination(const SDL_Surface* surface)
+	{
+		// Les noyaux ne dépendent pas de l'ordre des composantes de couleur, seulement de la place de l'alpha
+		if (surface->format->BytesPerPixel != 4 || surface->format->Amask != 0xFF000000)
+			throw std::runtime_error("blit destination must be a 32 bits surface with alpha in the high byte (ARGB8888, ABGR8888)");
+	}
+
+	// Renvoie la source si elle est déjà au format de la destination, sinon une copie convertie (gardée en vie par converted)
+	SDL_Surface* ConvertToFormat(SDL_Surface* source, const SDL_PixelFormat* format, std::optional<SDLppSurface>& converted)
+	{
+		if (source->format->format == format->format)
+			return source;
+
+		SDL_Surface* surface = SDL_ConvertSurfaceFormat(source, format->format, 0);
+		if (!surface)
+			throw std::runtime_error(std::string("failed to convert blit source: ") + SDL_GetError());
+
+		converted.emplace(surface);
+		return surface;
+	}
+
+	Uint32* GetPixels(SDL_Surface* surface, int x, int y)
+	{
+		return reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch) + x;
+	}
+
+	// Pixel source échantillonné au centre d'un pixel destination (le même choix que SDL_BlitScaled, à l'arrondi près)
+	int GetScaledCoordinate(int destinationOffset, int sourceStart, int sourceSize, int destinationSize)
+	{
+		return sourceStart + static_cast<int>((2 * static_cast<std::int64_t>(destinationOffset) + 1) * sourceSize / (2 * static_cast<std::int64_t>(destinationSize)));
+	}
+
+	Uint8 Premultiply(Uint8 component, Uint8 alpha)
+	{
+		return static_cast<Uint8>((component * alpha + 127) / 255);
+	}
+}
 
 SDLppSurface::SDLppSurface(SDL_Surface* surface) :
 m_surface(surface)
@@ -19,6 +181,146 @@ SDLppSurface::~SDLppSurface()
 		SDL_FreeSurface(m_surface);
 }
 
+void SDLppSurface::Blit(const SDLppSurface& source, int x, int y, SDLppAlphaMode alphaMode)
+{
+	SDL_Surface* sourceSurface = source.GetHandle();
+	Blit(source, SDL_Rect{ 0, 0, sourceSurface->w, sourceSurface->h }, x, y, alphaMode);
+}
+
+void SDLppSurface::Blit(const SDLppSurface& source, const SDL_Rect& sourceRect, int x, int y, SDLppAlphaMode alphaMode)
+{
+	CheckBlitDestination(m_surface);
+
+	std::optional<SDLppSurface> convertedSource;
+	SDL_Surface* sourceSurface = ConvertToFormat(source.GetHandle(), m_surface->format, convertedSource);
+
+	SDL_Rect sourceBounds = { 0, 0, sourceSurface->w, sourceSurface->h };
+	SDL_Rect clippedSource;
+	if (!SDL_IntersectRect(&sourceRect, &sourceBounds, &clippedSource))
+		return;
+
+	SDL_Rect destinationRect = { x + clippedSource.x - sourceRect.x, y + clippedSource.y - sourceRect.y, clippedSource.w, clippedSource.h };
+
+	SDL_Rect clipRect;
+	SDL_GetClipRect(m_surface, &clipRect);
+
+	SDL_Rect clippedDestination;
+	if (!SDL_IntersectRect(&destinationRect, &clipRect, &clippedDestination))
+		return;
+
+	int sourceX = clippedSource.x + clippedDestination.x - destinationRect.x;
+	int sourceY = clippedSource.y + clippedDestination.y - destinationRect.y;
+
+	const SDLppBlitKernels& kernels = *CurrentBlitKernels().load(std::memory_order_relaxed);
+	auto blend = (alphaMode == SDLppAlphaMode::Premultiplied) ? kernels.blendPremultiplied : kernels.blendStraight;
+
+	SurfaceLock sourceLock(sourceSurface);
+	SurfaceLock destinationLock(m_surface);
+
+	for (int row = 0; row < clippedDestination.h; ++row)
+		blend(GetPixels(m_surface, clippedDestination.x, clippedDestination.y + row), GetPixels(sourceSurface, sourceX, sourceY + row), clippedDestination.w);
+}
+
+void SDLppSurface::BlitScaled(const SDLppSurface& source, const SDL_Rect& destinationRect, SDLppAlphaMode alphaMode)
+{
+	SDL_Surface* sourceSurface = source.GetHandle();
+	BlitScaled(source, SDL_Rect{ 0, 0, sourceSurface->w, sourceSurface->h }, destinationRect, alphaMode);
+}
+
+void SDLppSurface::BlitScaled(const SDLppSurface& source, const SDL_Rect& sourceRect, const SDL_Rect& destinationRect, SDLppAlphaMode alphaMode)
+{
+	CheckBlitDestination(m_surface);
+
+	if (SDL_RectEmpty(&sourceRect) || SDL_RectEmpty(&destinationRect))
+		return;
+
+	SDL_Rect clipRect;
+	SDL_GetClipRect(m_surface, &clipRect);
+
+	SDL_Rect clippedDestination;
+	if (!SDL_IntersectRect(&destinationRect, &clipRect, &clippedDestination))
+		return;
+
+	std::optional<SDLppSurface> convertedSource;
+	SDL_Surface* sourceSurface = ConvertToFormat(source.GetHandle(), m_surface->format, convertedSource);
+
+	// Colonne source de chaque colonne destination ; la correspondance étant croissante, celles qui tombent hors de la source
+	// (rectangle source débordant) sont aux deux extrémités et sont retirées
+	std::vector<int> sourceColumns(clippedDestination.w);
+	for (int column = 0; column < clippedDestination.w; ++column)
+		sourceColumns[column] = GetScaledCoordinate(clippedDestination.x - destinationRect.x + column, sourceRect.x, sourceRect.w, destinationRect.w);
+
+	auto firstColumn = std::lower_bound(sourceColumns.begin(), sourceColumns.end(), 0);
+	auto lastColumn = std::lower_bound(firstColumn, sourceColumns.end(), sourceSurface->w);
+	if (firstColumn == lastColumn)
+		return;
+
+	int columnCount = static_cast<int>(lastColumn - firstColumn);
+	int destinationX = clippedDestination.x + static_cast<int>(firstColumn - sourceColumns.begin());
+
+	const SDLppBlitKernels& kernels = *CurrentBlitKernels().load(std::memory_order_relaxed);
+	auto blend = (alphaMode == SDLppAlphaMode::Premultiplied) ? kernels.blendPremultiplied : kernels.blendStraight;
+
+	SurfaceLock sourceLock(sourceSurface);
+	SurfaceLock destinationLock(m_surface);
+
+	// Chaque ligne source est rééchantillonnée dans une ligne temporaire, réutilisée tant que l'agrandissement retombe sur la même
+	std::vector<Uint32> scaledRow(columnCount);
+	int scaledSourceRow = -1;
+	for (int row = 0; row < clippedDestination.h; ++row)
+	{
+		int sourceRow = GetScaledCoordinate(clippedDestination.y - destinationRect.y + row, sourceRect.y, sourceRect.h, destinationRect.h);
+		if (sourceRow < 0 || sourceRow >= sourceSurface->h)
+			continue;
+
+		if (sourceRow != scaledSourceRow)
+		{
+			const Uint32* sourcePixels = GetPixels(sourceSurface, 0, sourceRow);
+			for (int column = 0; column < columnCount; ++column)
+				scaledRow[column] = sourcePixels[firstColumn[column]];
+
+			scaledSourceRow = sourceRow;
+		}
+
+		blend(GetPixels(m_surface, destinationX, clippedDestination.y + row), scaledRow.data(), columnCount);
+	}
+}
+
+void SDLppSurface::Fill(const SDL_Color& color, SDLppAlphaMode alphaMode)
+{
+	Fill(SDL_Rect{ 0, 0, m_surface->w, m_surface->h }, color, alphaMode);
+}
+
+void SDLppSurface::Fill(const SDL_Rect& rect, const SDL_Color& color, SDLppAlphaMode alphaMode)
+{
+	CheckBlitDestination(m_surface);
+
+	SDL_Rect clipRect;
+	SDL_GetClipRect(m_surface, &clipRect);
+
+	SDL_Rect fillRect;
+	if (!SDL_IntersectRect(&rect, &clipRect, &fillRect))
+		return;
+
+	const SDLppBlitKernels& kernels = *CurrentBlitKernels().load(std::memory_order_relaxed);
+
+	SurfaceLock lock(m_surface);
+
+	// Une couleur opaque est la même prémultipliée ou non, fillPremultiplied se contente alors de l'écrire
+	if (alphaMode == SDLppAlphaMode::Premultiplied || color.a == 255)
+	{
+		Uint32 pixel = SDL_MapRGBA(m_surface->format, Premultiply(color.r, color.a), Premultiply(color.g, color.a), Premultiply(color.b, color.a), color.a);
+		for (int row = 0; row < fillRect.h; ++row)
+			kernels.fillPremultiplied(GetPixels(m_surface, fillRect.x, fillRect.y + row), pixel, fillRect.w);
+	}
+	else
+	{
+		std::vector<Uint32> colorRow(fillRect.w, SDL_MapRGBA(m_surface->format, color.r, color.g, color.b, color.a));
+		for (int row = 0; row < fillRect.h; ++row)
+			kernels.blendStraight(GetPixels(m_surface, fillRect.x, fillRect.y + row), colorRow.data(), fillRect.w);
+	}
+}
+
 SDL_Surface* SDLppSurface::GetHandle() const
 {
 	return m_surface;
@@ -35,6 +337,16 @@ SDLppSurface& SDLppSurface::operator=(SDLppSurface&& surface)
 	return *this;
 }
 
+SDLppSurface SDLppSurface::Create(int width, int height)
+{
+	// Les pixels d'une nouvelle surface sont à zéro, donc transparents
+	SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+	if (!surface)
+		throw std::runtime_error(std::string("failed to create surface: ") + SDL_GetError());
+
+	return SDLppSurface(surface);
+}
+
 SDLppSurface SDLppSurface::FromFile(const std::string& filepath)
 {
 	SDL_Surface* surface = IMG_Load(filepath.c_str());
@@ -43,3 +355,33 @@ SDLppSurface SDLppSurface::FromFile(const std::string& filepath)
 
 	return SDLppSurface(surface);
 }
+
+std::future<SDLppSurface> SDLppSurface::FromFileAsync(std::string filepath)
+{
+	return DecodeWorkers::Instance().Push(std::packaged_task<SDLppSurface()>([filepath = std::move(filepath)] { return FromFile(filepath); }));
+}
+
+SDLppSurface SDLppSurface::FromMemory(const void* data, std::size_t size)
+{
+	// Le format est deviné à partir du contenu, comme pour un fichier
+	SDL_Surface* surface = IMG_Load_RW(SDL_RWFromConstMem(data, static_cast<int>(size)), 1);
+	if (!surface)
+		throw std::runtime_error(std::string("failed to load image from memory: ") + IMG_GetError());
+
+	return SDLppSurface(surface);
+}
+
+SDLppBlitBackend SDLppSurface::GetBlitBackend()
+{
+	return CurrentBlitKernels().load(std::memory_order_relaxed)->backend;
+}
+
+bool SDLppSurface::SetBlitBackend(SDLppBlitBackend backend)
+{
+	const SDLppBlitKernels* kernels = SDLppBlitKernels::Get(backend);
+	if (!kernels)
+		return false;
+
+	CurrentBlitKernels().store(kernels, std::memory_order_relaxed);
+	return true;
+}
\ No newline at end of file
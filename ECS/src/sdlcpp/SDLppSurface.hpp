@@ -1,8 +1,18 @@
 #pragma once
 
+#include "SDLppBlitKernels.hpp"
 #include <SDL2/SDL.h>
+#include <cstddef>
+#include <future>
 #include <string>
 
+// Manière dont les composantes de couleur d'une surface tiennent compte de son alpha
+enum class SDLppAlphaMode
+{
+	Straight,     //< Couleur indépendante de l'alpha (images chargées, SDL_BLENDMODE_BLEND)
+	Premultiplied //< Couleur déjà multipliée par l'alpha (compositions successives sans perte aux bords)
+};
+
 class SDLppSurface
 {
 public:
@@ -11,12 +21,34 @@ public:
 	SDLppSurface(SDLppSurface&& surface);
 	~SDLppSurface();
 
+	// Mélange alpha d'une autre surface dans celle-ci, avec les noyaux SSE2/AVX2 de SDLppBlitKernels (rendu sur CPU, sans renderer).
+	// La surface destination doit avoir 32 bits par pixel et son alpha dans l'octet de poids fort (ARGB8888, ABGR8888),
+	// la source est convertie à son format si nécessaire ; le clip rect de la destination est respecté
+	void Blit(const SDLppSurface& source, int x, int y, SDLppAlphaMode alphaMode = SDLppAlphaMode::Straight);
+	void Blit(const SDLppSurface& source, const SDL_Rect& sourceRect, int x, int y, SDLppAlphaMode alphaMode = SDLppAlphaMode::Straight);
+	// Mise à l'échelle au plus proche voisin (comme SDL_BlitScaled)
+	void BlitScaled(const SDLppSurface& source, const SDL_Rect& destinationRect, SDLppAlphaMode alphaMode = SDLppAlphaMode::Straight);
+	void BlitScaled(const SDLppSurface& source, const SDL_Rect& sourceRect, const SDL_Rect& destinationRect, SDLppAlphaMode alphaMode = SDLppAlphaMode::Straight);
+
+	// Mélange une couleur (non prémultipliée, comme toutes les SDL_Color) sur la surface, une couleur opaque la remplace simplement
+	void Fill(const SDL_Color& color, SDLppAlphaMode alphaMode = SDLppAlphaMode::Straight);
+	void Fill(const SDL_Rect& rect, const SDL_Color& color, SDLppAlphaMode alphaMode = SDLppAlphaMode::Straight);
+
 	SDL_Surface* GetHandle() const;
 
 	SDLppSurface& operator=(const SDLppSurface&) = delete;
 	SDLppSurface& operator=(SDLppSurface&& surface);
 
+	// Surface ARGB8888 entièrement transparente
+	static SDLppSurface Create(int width, int height);
 	static SDLppSurface FromFile(const std::string& filepath);
+	static std::future<SDLppSurface> FromFileAsync(std::string filepath);
+	static SDLppSurface FromMemory(const void* data, std::size_t size);
+
+	// Version des noyaux utilisée par Blit, BlitScaled et Fill (par défaut la plus rapide supportée par le processeur) ;
+	// SetBlitBackend renvoie false si la version demandée n'est pas disponible
+	static SDLppBlitBackend GetBlitBackend();
+	static bool SetBlitBackend(SDLppBlitBackend backend);
 
 private:
 	SDL_Surface* m_surface;
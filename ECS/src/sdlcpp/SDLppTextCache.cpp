@@ -0,0 +1,152 @@
+#include "SDLppTextCache.hpp"
+#include "SDLppFont.hpp"
+#include "SDLppRenderer.hpp"
+#include <functional>
+
+namespace
+{
+	Uint32 PackColor(const SDL_Color& color)
+	{
+		return (Uint32(color.r) << 24) | (Uint32(color.g) << 16) | (Uint32(color.b) << 8) | Uint32(color.a);
+	}
+
+	std::size_t HashKey(const SDLppFont* font, std::string_view text, Uint32 color)
+	{
+		std::size_t hash = std::hash<std::string_view>()(text);
+		hash ^= std::hash<const SDLppFont*>()(font) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<Uint32>()(color) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+
+		return hash;
+	}
+}
+
+SDLppTextCache::SDLppTextCache(const SDLppRenderer& renderer, std::size_t budget) :
+m_renderer(renderer),
+m_budget(budget),
+m_hitCount(0),
+m_memoryUsage(0),
+m_missCount(0)
+{
+}
+
+void SDLppTextCache::Clear()
+{
+	m_index.clear();
+	m_entries.clear();
+	m_memoryUsage = 0;
+}
+
+std::size_t SDLppTextCache::GetBudget() const
+{
+	return m_budget;
+}
+
+std::size_t SDLppTextCache::GetHitCount() const
+{
+	return m_hitCount;
+}
+
+std::size_t SDLppTextCache::GetMemoryUsage() const
+{
+	return m_memoryUsage;
+}
+
+std::size_t SDLppTextCache::GetMissCount() const
+{
+	return m_missCount;
+}
+
+std::size_t SDLppTextCache::GetTextureCount() const
+{
+	return m_entries.size();
+}
+
+std::shared_ptr<SDLppTexture> SDLppTextCache::Render(SDLppFont& font, std::string_view text, const SDL_Color& color)
+{
+	// TTF_RenderUTF8_Blended refuse une chaîne vide, et il n'y a de toute façon rien à afficher
+	if (text.empty())
+		return nullptr;
+
+	Uint32 packedColor = PackColor(color);
+
+	auto it = m_index.find(KeyView{ &font, text, packedColor });
+	if (it != m_index.end())
+	{
+		m_hitCount++;
+
+		// Le texte devient le plus récemment affiché
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+		return it->second->texture;
+	}
+
+	m_missCount++;
+
+	std::string textString(text);
+	std::shared_ptr<SDLppTexture> texture = SDLppTexture::FromSurface(m_renderer, font.RenderUTF8Blended(textString, color));
+
+	SDL_Rect rect = texture->GetRect();
+
+	auto indexIt = m_index.emplace(Key{ &font, std::move(textString), packedColor }, m_entries.end()).first;
+
+	Entry& entry = m_entries.emplace_front();
+	entry.texture = texture;
+	entry.key = &indexIt->first;
+	entry.memoryUsage = static_cast<std::size_t>(rect.w) * rect.h * 4;
+	indexIt->second = m_entries.begin();
+
+	m_memoryUsage += entry.memoryUsage;
+
+	// La texture renvoyée reste valide même si le cache l'oublie aussitôt (texte plus gros que le budget)
+	Trim();
+
+	return texture;
+}
+
+void SDLppTextCache::ResetCounters()
+{
+	m_hitCount = 0;
+	m_missCount = 0;
+}
+
+void SDLppTextCache::SetBudget(std::size_t budget)
+{
+	m_budget = budget;
+	Trim();
+}
+
+void SDLppTextCache::Trim()
+{
+	while (m_memoryUsage > m_budget && !m_entries.empty())
+	{
+		Entry& entry = m_entries.back();
+		m_memoryUsage -= entry.memoryUsage;
+
+		m_index.erase(m_index.find(*entry.key));
+		m_entries.pop_back();
+	}
+}
+
+std::size_t SDLppTextCache::KeyHash::operator()(const Key& key) const
+{
+	return HashKey(key.font, key.text, key.color);
+}
+
+std::size_t SDLppTextCache::KeyHash::operator()(const KeyView& key) const
+{
+	return HashKey(key.font, key.text, key.color);
+}
+
+bool SDLppTextCache::KeyEqual::operator()(const Key& lhs, const Key& rhs) const
+{
+	return lhs.font == rhs.font && lhs.color == rhs.color && lhs.text == rhs.text;
+}
+
+bool SDLppTextCache::KeyEqual::operator()(const Key& lhs, const KeyView& rhs) const
+{
+	return lhs.font == rhs.font && lhs.color == rhs.color && lhs.text == rhs.text;
+}
+
+bool SDLppTextCache::KeyEqual::operator()(const KeyView& lhs, const Key& rhs) const
+{
+	return operator()(rhs, lhs);
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "SDLppTexture.hpp"
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class SDLppFont;
+class SDLppRenderer;
+
+// Cache des textures de texte rendues par SDLppFont::RenderUTF8Blended, par police, texte et couleur :
+// un texte affiché à l'identique d'une frame à l'autre (libellé, nom, entrée de menu) ne coûte plus qu'une recherche.
+// Au-delà du budget mémoire, les textes les moins récemment affichés sont oubliés.
+class SDLppTextCache
+{
+public:
+	SDLppTextCache(const SDLppRenderer& renderer, std::size_t budget);
+	SDLppTextCache(const SDLppTextCache&) = delete;
+	SDLppTextCache(SDLppTextCache&&) = delete;
+	~SDLppTextCache() = default;
+
+	void Clear();
+
+	std::size_t GetBudget() const;
+	std::size_t GetHitCount() const;
+	std::size_t GetMemoryUsage() const;
+	std::size_t GetMissCount() const;
+	std::size_t GetTextureCount() const;
+
+	// Renvoie nullptr pour un texte vide
+	std::shared_ptr<SDLppTexture> Render(SDLppFont& font, std::string_view text, const SDL_Color& color = { 255, 255, 255, 255 });
+
+	void ResetCounters();
+	void SetBudget(std::size_t budget);
+
+	SDLppTextCache& operator=(const SDLppTextCache&) = delete;
+	SDLppTextCache& operator=(SDLppTextCache&&) = delete;
+
+private:
+	struct Key
+	{
+		const SDLppFont* font;
+		std::string text;
+		Uint32 color;
+	};
+
+	// Permet de chercher un texte sans construire de std::string
+	struct KeyView
+	{
+		const SDLppFont* font;
+		std::string_view text;
+		Uint32 color;
+	};
+
+	struct KeyHash
+	{
+		using is_transparent = void;
+
+		std::size_t operator()(const Key& key) const;
+		std::size_t operator()(const KeyView& key) const;
+	};
+
+	struct KeyEqual
+	{
+		using is_transparent = void;
+
+		bool operator()(const Key& lhs, const Key& rhs) const;
+		bool operator()(const Key& lhs, const KeyView& rhs) const;
+		bool operator()(const KeyView& lhs, const Key& rhs) const;
+	};
+
+	struct Entry
+	{
+		std::shared_ptr<SDLppTexture> texture;
+		const Key* key;
+		std::size_t memoryUsage;
+	};
+
+	using EntryList = std::list<Entry>;
+
+	void Trim();
+
+	EntryList m_entries; //< Du plus récemment affiché au plus ancien
+	std::unordered_map<Key, EntryList::iterator, KeyHash, KeyEqual> m_index;
+	const SDLppRenderer& m_renderer;
+	std::size_t m_budget;
+	std::size_t m_hitCount;
+	std::size_t m_memoryUsage;
+	std::size_t m_missCount;
+};
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "SDLppTextLayout.hpp"
+#include "SDLppGlyphAtlas.hpp"
+#include <algorithm>
+#include <cassert>
+
+SDLppTextLayout::SDLppTextLayout(SDLppGlyphAtlas& glyphAtlas, int maxWidth, SDLppTextAlignment alignment) :
+m_glyphAtlas(&glyphAtlas),
+m_alignment(alignment),
+m_lineCount(0),
+m_maxWidth(maxWidth)
+{
+}
+
+std::size_t SDLppTextLayout::AppendParagraph(std::string_view text)
+{
+	InsertParagraph(m_paragraphs.size(), text);
+	return m_paragraphs.size() - 1;
+}
+
+void SDLppTextLayout::Clear()
+{
+	m_paragraphs.clear();
+	m_lineCount = 0;
+}
+
+SDLppTextAlignment SDLppTextLayout::GetAlignment() const
+{
+	return m_alignment;
+}
+
+SDLppGlyphAtlas& SDLppTextLayout::GetGlyphAtlas() const
+{
+	return *m_glyphAtlas;
+}
+
+int SDLppTextLayout::GetHeight() const
+{
+	if (m_paragraphs.empty())
+		return 0;
+
+	return m_paragraphs.back().top + GetParagraphHeight(m_paragraphs.size() - 1);
+}
+
+std::size_t SDLppTextLayout::GetLineCount() const
+{
+	return m_lineCount;
+}
+
+int SDLppTextLayout::GetMaxWidth() const
+{
+	return m_maxWidth;
+}
+
+std::size_t SDLppTextLayout::GetParagraphAt(int y) const
+{
+	// Les paragraphes sont triés par ordonnée : premier paragraphe commençant après y, et on recule d'un
+	auto it = std::upper_bound(m_paragraphs.begin(), m_paragraphs.end(), y, [](int y, const Paragraph& paragraph) { return y < paragraph.top; });
+	if (it == m_paragraphs.begin())
+		return 0;
+
+	return static_cast<std::size_t>(std::distance(m_paragraphs.begin(), it)) - 1;
+}
+
+std::size_t SDLppTextLayout::GetParagraphCount() const
+{
+	return m_paragraphs.size();
+}
+
+const std::vector<SDLppPositionedGlyph>& SDLppTextLayout::GetParagraphGlyphs(std::size_t paragraphIndex) const
+{
+	assert(paragraphIndex < m_paragraphs.size());
+	return m_paragraphs[paragraphIndex].glyphs;
+}
+
+int SDLppTextLayout::GetParagraphHeight(std::size_t paragraphIndex) const
+{
+	assert(paragraphIndex < m_paragraphs.size());
+	return static_cast<int>(m_paragraphs[paragraphIndex].lineCount) * m_glyphAtlas->GetLineSkip();
+}
+
+const std::string& SDLppTextLayout::GetParagraphText(std::size_t paragraphIndex) const
+{
+	assert(paragraphIndex < m_paragraphs.size());
+	return m_paragraphs[paragraphIndex].text;
+}
+
+int SDLppTextLayout::GetParagraphTop(std::size_t paragraphIndex) const
+{
+	assert(paragraphIndex < m_paragraphs.size());
+	return m_paragraphs[paragraphIndex].top;
+}
+
+int SDLppTextLayout::GetParagraphWidth(std::size_t paragraphIndex) const
+{
+	assert(paragraphIndex < m_paragraphs.size());
+	return m_paragraphs[paragraphIndex].width;
+}
+
+void SDLppTextLayout::InsertParagraph(std::size_t paragraphIndex, std::string_view text)
+{
+	assert(paragraphIndex <= m_paragraphs.size());
+
+	Paragraph paragraph;
+	paragraph.text = text;
+	LayoutParagraph(paragraph);
+
+	m_lineCount += paragraph.lineCount;
+	m_paragraphs.insert(m_paragraphs.begin() + paragraphIndex, std::move(paragraph));
+
+	// Les paragraphes suivants sont seulement décalés, pas remis en page
+	UpdateTops(paragraphIndex);
+}
+
+void SDLppTextLayout::RemoveParagraph(std::size_t paragraphIndex)
+{
+	assert(paragraphIndex < m_paragraphs.size());
+
+	m_lineCount -= m_paragraphs[paragraphIndex].lineCount;
+	m_paragraphs.erase(m_paragraphs.begin() + paragraphIndex);
+
+	UpdateTops(paragraphIndex);
+}
+
+void SDLppTextLayout::SetAlignment(SDLppTextAlignment alignment)
+{
+	if (m_alignment == alignment)
+		return;
+
+	m_alignment = alignment;
+
+	m_lineCount = 0;
+	for (Paragraph& paragraph : m_paragraphs)
+	{
+		LayoutParagraph(paragraph);
+		m_lineCount += paragraph.lineCount;
+	}
+}
+
+void SDLppTextLayout::SetMaxWidth(int maxWidth)
+{
+	if (m_maxWidth == maxWidth)
+		return;
+
+	m_maxWidth = maxWidth;
+
+	m_lineCount = 0;
+	for (Paragraph& paragraph : m_paragraphs)
+	{
+		LayoutParagraph(paragraph);
+		m_lineCount += paragraph.lineCount;
+	}
+
+	UpdateTops(0);
+}
+
+void SDLppTextLayout::SetParagraph(std::size_t paragraphIndex, std::string_view text)
+{
+	assert(paragraphIndex < m_paragraphs.size());
+
+	Paragraph& paragraph = m_paragraphs[paragraphIndex];
+	std::size_t previousLineCount = paragraph.lineCount;
+
+	paragraph.text = text;
+	LayoutParagraph(paragraph);
+
+	m_lineCount = m_lineCount - previousLineCount + paragraph.lineCount;
+
+	// Si le nombre de lignes n'a pas changé, les paragraphes suivants restent en place
+	if (paragraph.lineCount != previousLineCount)
+		UpdateTops(paragraphIndex + 1);
+}
+
+void SDLppTextLayout::LayoutParagraph(Paragraph& paragraph)
+{
+	paragraph.glyphs.clear();
+	paragraph.lineCount = 0;
+	paragraph.width = 0;
+
+	// Position du stylo avant chaque caractère, comme si le paragraphe tenait sur une seule ligne :
+	// la largeur de n'importe quel morceau s'en déduit par une soustraction
+	m_codepoints.clear();
+	m_penPositions.clear();
+
+	int penX = 0;
+	Uint32 previousCodepoint = 0;
+	for (std::size_t offset = 0; offset < paragraph.text.size();)
+	{
+		Uint32 codepoint = SDLppGlyphAtlas::DecodeUTF8(paragraph.text, offset);
+		if (codepoint == '\n')
+		{
+			m_codepoints.push_back(codepoint);
+			m_penPositions.push_back(penX);
+			previousCodepoint = 0;
+			continue;
+		}
+
+		if (previousCodepoint != 0)
+			penX += m_glyphAtlas->GetKerning(previousCodepoint, codepoint);
+
+		m_codepoints.push_back(codepoint);
+		m_penPositions.push_back(penX);
+
+		penX += m_glyphAtlas->GetGlyph(codepoint).advance;
+		previousCodepoint = codepoint;
+	}
+	m_penPositions.push_back(penX);
+
+	int lineSkip = m_glyphAtlas->GetLineSkip();
+
+	auto EmitLine = [&](std::size_t first, std::size_t last)
+	{
+		// Les espaces de fin de ligne ne comptent pas pour l'alignement
+		std::size_t visibleLast = last;
+		while (visibleLast > first && m_codepoints[visibleLast - 1] == ' ')
+			visibleLast--;
+
+		int lineWidth = m_penPositions[visibleLast] - m_penPositions[first];
+		paragraph.width = std::max(paragraph.width, lineWidth);
+
+		int offsetX = 0;
+		if (m_maxWidth > 0)
+		{
+			if (m_alignment == SDLppTextAlignment::Center)
+				offsetX = (m_maxWidth - lineWidth) / 2;
+			else if (m_alignment == SDLppTextAlignment::Right)
+				offsetX = m_maxWidth - lineWidth;
+		}
+
+		int y = static_cast<int>(paragraph.lineCount) * lineSkip;
+		for (std::size_t i = first; i < visibleLast; ++i)
+		{
+			const SDLppGlyph& glyph = m_glyphAtlas->GetGlyph(m_codepoints[i]);
+			if (SDL_RectEmpty(&glyph.rect))
+				continue;
+
+			paragraph.glyphs.push_back(SDLppPositionedGlyph{ glyph.rect, glyph.page, offsetX + m_penPositions[i] - m_penPositions[first], y });
+		}
+
+		paragraph.lineCount++;
+	};
+
+	// Retour à la ligne glouton : la ligne est coupée au dernier espace rencontré dès qu'un caractère dépasse,
+	// ou au milieu du mot s'il est à lui seul plus large que la ligne
+	constexpr std::size_t NoBreak = SIZE_MAX;
+
+	std::size_t lineStart = 0;
+	std::size_t lastBreak = NoBreak;
+	for (std::size_t i = 0; i < m_codepoints.size(); ++i)
+	{
+		Uint32 codepoint = m_codepoints[i];
+		if (codepoint == '\n')
+		{
+			EmitLine(lineStart, i);
+			lineStart = i + 1;
+			lastBreak = NoBreak;
+			continue;
+		}
+
+		if (codepoint == ' ')
+		{
+			lastBreak = i;
+			continue;
+		}
+
+		while (m_maxWidth > 0 && i > lineStart && m_penPositions[i + 1] - m_penPositions[lineStart] > m_maxWidth)
+		{
+			if (lastBreak != NoBreak && lastBreak > lineStart)
+			{
+				EmitLine(lineStart, lastBreak);
+				lineStart = lastBreak + 1;
+			}
+			else
+			{
+				EmitLine(lineStart, i);
+				lineStart = i;
+			}
+
+			lastBreak = NoBreak;
+		}
+	}
+
+	// Un paragraphe vide occupe tout de même une ligne
+	EmitLine(lineStart, m_codepoints.size());
+}
+
+void SDLppTextLayout::UpdateTops(std::size_t firstParagraph)
+{
+	int lineSkip = m_glyphAtlas->GetLineSkip();
+
+	int top = (firstParagraph > 0) ? m_paragraphs[firstParagraph - 1].top + static_cast<int>(m_paragraphs[firstParagraph - 1].lineCount) * lineSkip : 0;
+	for (std::size_t i = firstParagraph; i < m_paragraphs.size(); ++i)
+	{
+		m_paragraphs[i].top = top;
+		top += static_cast<int>(m_paragraphs[i].lineCount) * lineSkip;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class SDLppGlyphAtlas;
+
+enum class SDLppTextAlignment
+{
+	Left,
+	Center,
+	Right
+};
+
+struct SDLppPositionedGlyph
+{
+	SDL_Rect rect;     //< Dans la page de l'atlas
+	std::size_t page;
+	int x;             //< Relativement au coin supérieur gauche du paragraphe
+	int y;
+};
+
+// Mise en page d'un texte découpé en paragraphes (une ligne de journal, une bulle d'aide...) :
+// retour à la ligne automatique entre les mots, alignement et crénage.
+// Chaque paragraphe garde le résultat de sa mise en page (la liste des glyphes à afficher et leur position),
+// seuls ceux modifiés sont remis en page : ajouter une ligne à un journal de 10 000 lignes ne coûte que cette ligne.
+class SDLppTextLayout
+{
+public:
+	// maxWidth <= 0 : pas de retour à la ligne automatique, le texte est alors aligné sur l'abscisse d'affichage
+	SDLppTextLayout(SDLppGlyphAtlas& glyphAtlas, int maxWidth, SDLppTextAlignment alignment = SDLppTextAlignment::Left);
+	SDLppTextLayout(const SDLppTextLayout&) = delete;
+	SDLppTextLayout(SDLppTextLayout&&) = default;
+	~SDLppTextLayout() = default;
+
+	std::size_t AppendParagraph(std::string_view text);
+
+	void Clear();
+
+	SDLppTextAlignment GetAlignment() const;
+	SDLppGlyphAtlas& GetGlyphAtlas() const;
+	int GetHeight() const;
+	std::size_t GetLineCount() const;
+	int GetMaxWidth() const;
+	// Index du paragraphe couvrant l'ordonnée y (relative au haut du texte), borné au premier et au dernier
+	std::size_t GetParagraphAt(int y) const;
+	std::size_t GetParagraphCount() const;
+	const std::vector<SDLppPositionedGlyph>& GetParagraphGlyphs(std::size_t paragraphIndex) const;
+	int GetParagraphHeight(std::size_t paragraphIndex) const;
+	const std::string& GetParagraphText(std::size_t paragraphIndex) const;
+	int GetParagraphTop(std::size_t paragraphIndex) const;
+	int GetParagraphWidth(std::size_t paragraphIndex) const;
+
+	void InsertParagraph(std::size_t paragraphIndex, std::string_view text);
+
+	void RemoveParagraph(std::size_t paragraphIndex);
+
+	// Changer l'alignement ou la largeur remet en page tous les paragraphes
+	void SetAlignment(SDLppTextAlignment alignment);
+	void SetMaxWidth(int maxWidth);
+	void SetParagraph(std::size_t paragraphIndex, std::string_view text);
+
+	SDLppTextLayout& operator=(const SDLppTextLayout&) = delete;
+	SDLppTextLayout& operator=(SDLppTextLayout&&) = default;
+
+private:
+	struct Paragraph
+	{
+		std::string text;
+		std::vector<SDLppPositionedGlyph> glyphs;
+		std::size_t lineCount;
+		int top;
+		int width;
+	};
+
+	void LayoutParagraph(Paragraph& paragraph);
+	void UpdateTops(std::size_t firstParagraph);
+
+	std::vector<Paragraph> m_paragraphs;
+	std::vector<Uint32> m_codepoints;   //< Réutilisés d'une mise en page à l'autre
+	std::vector<int> m_penPositions;
+	SDLppGlyphAtlas* m_glyphAtlas;
+	SDLppTextAlignment m_alignment;
+	std::size_t m_lineCount;
+	int m_maxWidth;
+};
\ No newline at end of file
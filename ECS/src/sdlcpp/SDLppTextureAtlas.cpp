@@ -0,0 +1,109 @@
+#include "SDLppTextureAtlas.hpp"
+#include "SDLppRenderer.hpp"
+#include "SDLppSkylinePacker.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+SDLppTextureAtlasBuilder::SDLppTextureAtlasBuilder(int pageWidth, int pageHeight, int padding) :
+m_padding(padding),
+m_pageHeight(pageHeight),
+m_pageWidth(pageWidth)
+{
+}
+
+std::size_t SDLppTextureAtlasBuilder::Add(SDLppSurface surface)
+{
+	SDL_Surface* handle = surface.GetHandle();
+	if (handle->w + 2 * m_padding > m_pageWidth || handle->h + 2 * m_padding > m_pageHeight)
+		throw std::runtime_error("image of size " + std::to_string(handle->w) + "x" + std::to_string(handle->h) + " does not fit in an atlas page");
+
+	m_surfaces.push_back(std::move(surface));
+	return m_surfaces.size() - 1;
+}
+
+std::vector<SDLppAtlasRegion> SDLppTextureAtlasBuilder::Build(const SDLppRenderer& renderer) const
+{
+	// Les images les plus hautes sont rangées en premier, le packer laisse alors beaucoup moins de trous
+	std::vector<std::size_t> order(m_surfaces.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs)
+	{
+		const SDL_Surface* lhsSurface = m_surfaces[lhs].GetHandle();
+		const SDL_Surface* rhsSurface = m_surfaces[rhs].GetHandle();
+		if (lhsSurface->h != rhsSurface->h)
+			return lhsSurface->h > rhsSurface->h;
+
+		return lhsSurface->w > rhsSurface->w;
+	});
+
+	// Chaque image est entourée d'une marge transparente, pour que le filtrage d'une image ne déborde pas sur ses voisines
+	std::vector<SDLppSkylinePacker> pages;
+	std::vector<std::size_t> imagePages(m_surfaces.size());
+	std::vector<SDL_Rect> imageRects(m_surfaces.size());
+	for (std::size_t imageIndex : order)
+	{
+		const SDL_Surface* surface = m_surfaces[imageIndex].GetHandle();
+
+		SDL_Rect paddedRect;
+		std::size_t pageIndex = 0;
+		for (; pageIndex < pages.size(); ++pageIndex)
+		{
+			if (pages[pageIndex].Insert(surface->w + 2 * m_padding, surface->h + 2 * m_padding, paddedRect))
+				break;
+		}
+
+		if (pageIndex == pages.size())
+		{
+			pages.emplace_back(m_pageWidth, m_pageHeight);
+			pages.back().Insert(surface->w + 2 * m_padding, surface->h + 2 * m_padding, paddedRect);
+		}
+
+		imagePages[imageIndex] = pageIndex;
+		imageRects[imageIndex] = SDL_Rect{ paddedRect.x + m_padding, paddedRect.y + m_padding, surface->w, surface->h };
+	}
+
+	// Les pages ne sont pas plus hautes que nécessaire
+	std::vector<SDLppSurface> pageSurfaces;
+	for (const SDLppSkylinePacker& page : pages)
+	{
+		SDL_Surface* pageSurface = SDL_CreateRGBSurfaceWithFormat(0, page.GetWidth(), page.GetUsedHeight(), 32, SDL_PIXELFORMAT_RGBA32);
+		if (!pageSurface)
+			throw std::runtime_error(std::string("failed to create atlas page: ") + SDL_GetError());
+
+		pageSurfaces.emplace_back(pageSurface);
+		SDL_FillRect(pageSurface, nullptr, SDL_MapRGBA(pageSurface->format, 0, 0, 0, 0));
+	}
+
+	for (std::size_t imageIndex = 0; imageIndex < m_surfaces.size(); ++imageIndex)
+	{
+		// On recopie les pixels tels quels (alpha compris) plutôt que de les mélanger au fond de la page
+		SDL_Surface* surface = m_surfaces[imageIndex].GetHandle();
+
+		SDL_BlendMode blendMode;
+		SDL_GetSurfaceBlendMode(surface, &blendMode);
+		SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+
+		SDL_Rect dstRect = imageRects[imageIndex];
+		SDL_BlitSurface(surface, nullptr, pageSurfaces[imagePages[imageIndex]].GetHandle(), &dstRect);
+
+		SDL_SetSurfaceBlendMode(surface, blendMode);
+	}
+
+	std::vector<std::shared_ptr<SDLppTexture>> pageTextures;
+	for (const SDLppSurface& pageSurface : pageSurfaces)
+	{
+		pageTextures.push_back(SDLppTexture::FromSurface(renderer, pageSurface));
+		SDL_SetTextureBlendMode(pageTextures.back()->GetHandle(), SDL_BLENDMODE_BLEND);
+	}
+
+	std::vector<SDLppAtlasRegion> regions(m_surfaces.size());
+	for (std::size_t imageIndex = 0; imageIndex < m_surfaces.size(); ++imageIndex)
+	{
+		regions[imageIndex].texture = pageTextures[imagePages[imageIndex]];
+		regions[imageIndex].rect = imageRects[imageIndex];
+	}
+
+	return regions;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "SDLppSurface.hpp"
+#include "SDLppTexture.hpp"
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class SDLppRenderer;
+
+// Une image rangée dans un atlas : la texture (partagée avec les autres images de la page) et la partie de celle-ci
+// qu'elle occupe, à passer en srcRect à SDLppRenderer::Copy
+struct SDLppAtlasRegion
+{
+	std::shared_ptr<SDLppTexture> texture;
+	SDL_Rect rect;
+};
+
+// Regroupe de nombreuses images dans une ou quelques grandes textures, pour que le renderer n'ait plus à changer
+// de texture à chaque image affichée (ce qui permet à SDL de regrouper les affichages consécutifs)
+class SDLppTextureAtlasBuilder
+{
+public:
+	SDLppTextureAtlasBuilder(int pageWidth = 2048, int pageHeight = 2048, int padding = 1);
+	SDLppTextureAtlasBuilder(const SDLppTextureAtlasBuilder&) = delete;
+	SDLppTextureAtlasBuilder(SDLppTextureAtlasBuilder&&) = default;
+	~SDLppTextureAtlasBuilder() = default;
+
+	// Renvoie l'indice de l'image, qui est aussi celui de sa région dans le résultat de Build
+	std::size_t Add(SDLppSurface surface);
+
+	std::vector<SDLppAtlasRegion> Build(const SDLppRenderer& renderer) const;
+
+	SDLppTextureAtlasBuilder& operator=(const SDLppTextureAtlasBuilder&) = delete;
+	SDLppTextureAtlasBuilder& operator=(SDLppTextureAtlasBuilder&&) = default;
+
+private:
+	std::vector<SDLppSurface> m_surfaces;
+	int m_padding;
+	int m_pageHeight;
+	int m_pageWidth;
+};
\ No newline at end of file
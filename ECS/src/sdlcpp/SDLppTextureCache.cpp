@@ -0,0 +1,193 @@
+#include "SDLppTextureCache.hpp"
+#include "SDLppRenderer.hpp"
+#include "SDLppSurface.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+SDLppTextureCache::SDLppTextureCache(const SDLppRenderer& renderer, std::size_t budget) :
+m_renderer(renderer),
+m_budget(budget),
+m_memoryUsage(0)
+{
+}
+
+void SDLppTextureCache::Clear()
+{
+	// Les textures encore utilisées restent valides : seul le cache cesse de les référencer
+	m_pathIndex.clear();
+	m_contentIndex.clear();
+	m_entries.clear();
+	m_memoryUsage = 0;
+}
+
+std::size_t SDLppTextureCache::GetBudget() const
+{
+	return m_budget;
+}
+
+std::size_t SDLppTextureCache::GetMemoryUsage() const
+{
+	return m_memoryUsage;
+}
+
+std::size_t SDLppTextureCache::GetTextureCount() const
+{
+	return m_entries.size();
+}
+
+std::shared_ptr<SDLppTexture> SDLppTextureCache::Insert(const std::string& filepath, std::shared_ptr<SDLppTexture> texture)
+{
+	auto pathIt = m_pathIndex.find(filepath);
+	if (pathIt != m_pathIndex.end())
+		return Acquire(pathIt->second);
+
+	Uint32 format;
+	int width, height;
+	SDL_QueryTexture(texture->GetHandle(), &format, nullptr, &width, &height);
+
+	// Pas de hash de contenu : l'entrée n'est accessible que par son chemin
+	Entry entry;
+	entry.texture = std::move(texture);
+	entry.paths.push_back(filepath);
+	entry.contentHash = 0;
+	entry.contentSize = 0;
+	entry.memoryUsage = static_cast<std::size_t>(width) * height * std::max<std::size_t>(SDL_BYTESPERPIXEL(format), 1);
+
+	m_entries.push_front(std::move(entry));
+	m_pathIndex.emplace(filepath, m_entries.begin());
+	m_memoryUsage += m_entries.front().memoryUsage;
+
+	std::shared_ptr<SDLppTexture> inserted = m_entries.front().texture;
+	Trim();
+
+	return inserted;
+}
+
+std::shared_ptr<SDLppTexture> SDLppTextureCache::Load(const std::string& filepath)
+{
+	auto pathIt = m_pathIndex.find(filepath);
+	if (pathIt != m_pathIndex.end())
+		return Acquire(pathIt->second);
+
+	// Chemin inconnu : le contenu du fichier a peut-être déjà été chargé sous un autre nom
+	std::ifstream file(filepath, std::ios::binary);
+	if (!file)
+		throw std::runtime_error("failed to open " + filepath);
+
+	std::vector<char> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	EntryList::iterator it;
+	try
+	{
+		it = FindOrCreate(content.data(), content.size());
+	}
+	catch (const std::exception& e)
+	{
+		throw std::runtime_error("failed to load " + filepath + ": " + e.what());
+	}
+
+	it->paths.push_back(filepath);
+	m_pathIndex.emplace(filepath, it);
+
+	return Acquire(it);
+}
+
+std::shared_ptr<SDLppTexture> SDLppTextureCache::LoadFromMemory(const void* data, std::size_t size)
+{
+	return Acquire(FindOrCreate(data, size));
+}
+
+void SDLppTextureCache::SetBudget(std::size_t budget)
+{
+	m_budget = budget;
+	Trim();
+}
+
+void SDLppTextureCache::Trim()
+{
+	// On remonte depuis la texture la moins récemment demandée, en épargnant celles encore référencées ailleurs
+	auto it = m_entries.end();
+	while (m_memoryUsage > m_budget && it != m_entries.begin())
+	{
+		--it;
+		if (it->texture.use_count() > 1)
+			continue;
+
+		for (const std::string& path : it->paths)
+			m_pathIndex.erase(path);
+
+		auto range = m_contentIndex.equal_range(it->contentHash);
+		for (auto contentIt = range.first; contentIt != range.second; ++contentIt)
+		{
+			if (contentIt->second == it)
+			{
+				m_contentIndex.erase(contentIt);
+				break;
+			}
+		}
+
+		m_memoryUsage -= it->memoryUsage;
+		it = m_entries.erase(it);
+	}
+}
+
+std::shared_ptr<SDLppTexture> SDLppTextureCache::Acquire(EntryList::iterator it)
+{
+	// La texture devient la plus récemment demandée
+	m_entries.splice(m_entries.begin(), m_entries, it);
+
+	return it->texture;
+}
+
+auto SDLppTextureCache::FindOrCreate(const void* data, std::size_t size) -> EntryList::iterator
+{
+	std::uint64_t contentHash = HashContent(data, size);
+
+	// Une collision de hash entre deux fichiers de même taille est assez improbable pour être ignorée
+	auto range = m_contentIndex.equal_range(contentHash);
+	for (auto contentIt = range.first; contentIt != range.second; ++contentIt)
+	{
+		if (contentIt->second->contentSize == size)
+			return contentIt->second;
+	}
+
+	std::shared_ptr<SDLppTexture> texture = SDLppTexture::FromSurface(m_renderer, SDLppSurface::FromMemory(data, size));
+
+	Uint32 format;
+	int width, height;
+	SDL_QueryTexture(texture->GetHandle(), &format, nullptr, &width, &height);
+
+	Entry entry;
+	entry.texture = std::move(texture);
+	entry.contentHash = contentHash;
+	entry.contentSize = size;
+	entry.memoryUsage = static_cast<std::size_t>(width) * height * std::max<std::size_t>(SDL_BYTESPERPIXEL(format), 1);
+
+	m_entries.push_front(std::move(entry));
+	m_contentIndex.emplace(contentHash, m_entries.begin());
+	m_memoryUsage += m_entries.front().memoryUsage;
+
+	// La nouvelle texture est référencée par l'appelant dès son retour, elle ne peut pas être celle qui est libérée
+	auto it = m_entries.begin();
+	std::shared_ptr<SDLppTexture> keepAlive = it->texture;
+	Trim();
+
+	return it;
+}
+
+std::uint64_t SDLppTextureCache::HashContent(const void* data, std::size_t size)
+{
+	// FNV-1a 64 bits, largement suffisant pour distinguer des fichiers image
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+	std::uint64_t hash = 14695981039346656037ull;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
\ No newline at end of file
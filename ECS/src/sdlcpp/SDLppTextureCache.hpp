@@ -0,0 +1,71 @@
+#pragma once
+
+#include "SDLppTexture.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SDLppRenderer;
+
+// Cache de textures : une image chargée plusieurs fois (même chemin, ou même contenu sous un autre chemin)
+// n'est décodée et envoyée au GPU qu'une seule fois, toutes les demandes partageant la même texture.
+// Les textures qui ne sont plus référencées qu'à travers le cache restent disponibles tant que la mémoire
+// qu'elles occupent tient dans le budget, au-delà les moins récemment demandées sont libérées.
+class SDLppTextureCache
+{
+public:
+	SDLppTextureCache(const SDLppRenderer& renderer, std::size_t budget);
+	SDLppTextureCache(const SDLppTextureCache&) = delete;
+	SDLppTextureCache(SDLppTextureCache&&) = delete;
+	~SDLppTextureCache() = default;
+
+	void Clear();
+
+	std::size_t GetBudget() const;
+	std::size_t GetMemoryUsage() const;
+	std::size_t GetTextureCount() const;
+
+	// Référence sous ce chemin une texture chargée hors du cache (par exemple par SDLppRenderer::LoadTextureAsync),
+	// afin que les Load suivants la partagent ; si le chemin est déjà connu, c'est la texture du cache qui est renvoyée.
+	// Son contenu n'étant pas connu, elle ne sera pas retrouvée par un chargement du même fichier sous un autre nom
+	std::shared_ptr<SDLppTexture> Insert(const std::string& filepath, std::shared_ptr<SDLppTexture> texture);
+
+	std::shared_ptr<SDLppTexture> Load(const std::string& filepath);
+	std::shared_ptr<SDLppTexture> LoadFromMemory(const void* data, std::size_t size);
+
+	void SetBudget(std::size_t budget);
+
+	// Libère les textures inutilisées les moins récemment demandées jusqu'à revenir sous le budget
+	void Trim();
+
+	SDLppTextureCache& operator=(const SDLppTextureCache&) = delete;
+	SDLppTextureCache& operator=(SDLppTextureCache&&) = delete;
+
+private:
+	struct Entry
+	{
+		std::shared_ptr<SDLppTexture> texture;
+		std::vector<std::string> paths;
+		std::uint64_t contentHash;
+		std::size_t contentSize;
+		std::size_t memoryUsage;
+	};
+
+	using EntryList = std::list<Entry>;
+
+	std::shared_ptr<SDLppTexture> Acquire(EntryList::iterator it);
+	EntryList::iterator FindOrCreate(const void* data, std::size_t size);
+
+	static std::uint64_t HashContent(const void* data, std::size_t size);
+
+	EntryList m_entries; //< Du plus récemment demandé au plus ancien
+	std::unordered_map<std::string, EntryList::iterator> m_pathIndex;
+	std::unordered_multimap<std::uint64_t, EntryList::iterator> m_contentIndex;
+	const SDLppRenderer& m_renderer;
+	std::size_t m_budget;
+	std::size_t m_memoryUsage;
+};
\ No newline at end of file
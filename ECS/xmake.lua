@@ -6,7 +6,7 @@ add_rules("mode.debug", "mode.release")
 -- Activation de l'auto-régénération de projet vsxmake à la modification
 add_rules("plugin.vsxmake.autoupdate")
 
-set_languages("c++17")
+set_languages("c++20")
 
 set_targetdir("./bin")
 
@@ -16,19 +16,96 @@ target("sdlcpp")
     add_files("src/sdlcpp/**.cpp")
     add_packages("libsdl", "libsdl_image", "libsdl_ttf", { public = true })
 
+target("ecs")
+    set_kind("static")
+    add_headerfiles("src/ecs/**.hpp")
+    add_files("src/ecs/**.cpp")
+    -- Le découpage en shards repose sur les sockets UNIX
+    if is_plat("windows") then
+        remove_headerfiles("src/ecs/SpatialShard.hpp")
+        remove_files("src/ecs/SpatialShard.cpp")
+    end
+    add_includedirs("src", { public = true })
+    add_packages("entt", { public = true })
+    add_deps("sdlcpp")
+    if is_plat("linux") then
+        add_syslinks("pthread", { public = true })
+    end
+    if is_plat("windows") then
+        add_syslinks("ws2_32", { public = true })
+    end
+
 target("Exemple1")
     set_kind("binary")
     add_files("src/exemple1.cpp")
+    add_includedirs("src")
     add_packages("entt")
 
 target("Exemple2")
     set_kind("binary")
     add_files("src/exemple2.cpp")
     add_packages("entt")
-    add_deps("sdlcpp")
+    add_deps("ecs", "sdlcpp")
 
 target("Exemple3")
     set_kind("binary")
     add_files("src/exemple3.cpp")
     add_packages("entt")
-    add_deps("sdlcpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple4")
+    set_kind("binary")
+    add_files("src/exemple4.cpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple5")
+    set_kind("binary")
+    add_files("src/exemple5.cpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple6")
+    set_kind("binary")
+    add_files("src/exemple6.cpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple7")
+    set_kind("binary")
+    add_files("src/exemple7.cpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple8")
+    set_kind("binary")
+    add_files("src/exemple8.cpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple9")
+    set_kind("binary")
+    add_files("src/exemple9.cpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple11")
+    set_kind("binary")
+    add_files("src/exemple11.cpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple12")
+    set_kind("binary")
+    add_files("src/exemple12.cpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple13")
+    set_kind("binary")
+    add_files("src/exemple13.cpp")
+    add_deps("ecs", "sdlcpp")
+
+target("Exemple14")
+    set_kind("binary")
+    add_files("src/exemple14.cpp")
+    add_deps("ecs", "sdlcpp")
+
+if not is_plat("windows") then
+    target("Exemple10")
+        set_kind("binary")
+        add_files("src/exemple10.cpp")
+        add_deps("ecs", "sdlcpp")
+end